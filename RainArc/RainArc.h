@@ -3,7 +3,13 @@
 #include "RainCache.h"
 #include "RainArcLru.h"
 #include "RainArcLfu.h"
+#include <cmath>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace RainCache
 {
@@ -15,8 +21,8 @@ namespace RainCache
     explicit RainArc(size_t capacity = 10, size_t transformThreshold = 2)
         : capacity_(capacity),
           transformThreshold_(transformThreshold),
-          lruPart_(std::make_unique<ArcLruPart<Key, Value>>(capacity, transformThreshold)),
-          lfuPart_(std::make_unique<ArcLfuPart<Key, Value>>(capacity, transformThreshold))
+          lruPart_(std::make_unique<ArcLruPart<Key, Value>>(capacity, transformThreshold, &stats_, &onEvict_)),
+          lfuPart_(std::make_unique<ArcLfuPart<Key, Value>>(capacity, transformThreshold, &stats_, &onEvict_))
     {
     }
 
@@ -25,23 +31,151 @@ namespace RainCache
     // 存入缓存
     void put(Key key, Value value) override
     {
-      bool inGhost = checkGhostCaches(key);
+      std::lock_guard<std::mutex> lock(mutex_);
+      putInternal(key, value);
+    }
+
+    // 读取缓存
+    bool get(Key key, Value &value) override
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return getInternal(key, value);
+    }
+
+    // 读取缓存
+    Value get(Key key) override
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素，两部分都不再驻留；不进入幽灵列表，也不调整容量划分
+    void remove(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!lruPart_->remove(key))
+        lfuPart_->remove(key);
+    }
 
-      if (!inGhost)
+    // 批量存入，整批只加一次锁
+    void putBatch(const std::vector<std::pair<Key, Value>> &entries)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto &entry : entries)
       {
-        if (lruPart_->put(key, value))
+        putInternal(entry.first, entry.second);
+      }
+    }
+
+    // 批量读取，values/found 与 keys 一一对应，返回命中数量
+    size_t getBatch(const std::vector<Key> &keys, std::vector<Value> &values, std::vector<bool> &found)
+    {
+      values.resize(keys.size());
+      found.assign(keys.size(), false);
+
+      size_t hits = 0;
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        if (getInternal(keys[i], values[i]))
         {
-          lfuPart_->put(key, value);
+          found[i] = true;
+          ++hits;
         }
       }
-      else
+      return hits;
+    }
+
+    // 当前驻留的不同 key 数量
+    size_t size() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return lruPart_->size() + lfuPart_->size();
+    }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    // 设置淘汰回调，两部分的淘汰都会触发，需在并发访问开始前设置
+    void setEvictionCallback(EvictionCallback<Key, Value> callback) { onEvict_ = std::move(callback); }
+
+    // 保存快照到文件，包括两部分当前的容量划分
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      SnapshotWriter out;
+      if (!out.open(path))
+        return false;
+      out.writeHeader(SnapshotPolicy::Arc);
+      writeSnapshot<KeySerializer, ValueSerializer>(out);
+      return out.close();
+    }
+
+    // 从文件加载快照，替换当前全部内容；文件损坏或策略不符时返回 false
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path)
+    {
+      SnapshotReader in;
+      if (!in.open(path) || !in.readHeader(SnapshotPolicy::Arc))
+        return false;
+      return readSnapshot<KeySerializer, ValueSerializer>(in);
+    }
+
+    // 写出两部分的状态（不含文件头）
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      lruPart_->template writeSnapshot<KeySerializer, ValueSerializer>(out);
+      lfuPart_->template writeSnapshot<KeySerializer, ValueSerializer>(out);
+    }
+
+    // 读入两部分的状态（不含文件头），幽灵列表不保存，加载后从空开始
+    // 先读入新建的两部分，全部成功后才替换，失败时保留原有内容；
+    // 两部分容量之和保持为构造时的 2 * capacity，只按快照中的比例划分，放不下的最旧/频率最低条目直接丢弃
+    // 读入时每部分最多保留 2 * capacity 条，快照来自更大的缓存或条目数被篡改时都不会按文件中的数量分配内存
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool readSnapshot(SnapshotReader &in)
+    {
+      uint64_t total = 2 * static_cast<uint64_t>(capacity_);
+      auto lruPart = std::make_unique<ArcLruPart<Key, Value>>(capacity_, transformThreshold_, &stats_, &onEvict_);
+      auto lfuPart = std::make_unique<ArcLfuPart<Key, Value>>(capacity_, transformThreshold_, &stats_, &onEvict_);
+      if (!lruPart->template readSnapshot<KeySerializer, ValueSerializer>(in, total) ||
+          !lfuPart->template readSnapshot<KeySerializer, ValueSerializer>(in, total))
+        return false;
+
+      double saved = static_cast<double>(lruPart->capacity()) + lfuPart->capacity();
+      uint64_t lruCapacity = saved == 0 ? capacity_ : std::min<uint64_t>(total, std::llround(lruPart->capacity() / saved * total));
+      lruPart->resetCapacity(lruCapacity);
+      lfuPart->resetCapacity(total - lruCapacity);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      lruPart_ = std::move(lruPart);
+      lfuPart_ = std::move(lfuPart);
+      return true;
+    }
+
+  private:
+    // 存入缓存
+    // 每个 key 只驻留在一侧：已晋升到 LFU 部分的直接在 LFU 中更新，否则写入 LRU 部分
+    // LRU 部分容量被幽灵命中调到 0 时改写入 LFU 部分，不丢弃这次写入
+    void putInternal(const Key &key, const Value &value)
+    {
+      stats_.recordPut();
+      checkGhostCaches(key);
+
+      if (lfuPart_->contains(key))
       {
-        lruPart_->put(key, value);
+        lfuPart_->put(key, value);
+        return;
       }
+      if (!lruPart_->put(key, value))
+        lfuPart_->put(key, value);
     }
 
     // 读取缓存
-    bool get(Key key, Value &value) override
+    bool getInternal(const Key &key, Value &value)
     {
       checkGhostCaches(key);
 
@@ -50,22 +184,24 @@ namespace RainCache
       {
         if (shouldTransform)
         {
-          lfuPart_->put(key, value);
+          // 访问次数达到门槛，从 LRU 部分移动到 LFU 部分，而不是复制一份
+          // 先写入 LFU 部分，成功后才从 LRU 部分移除；LFU 容量为 0 时留在 LRU 部分
+          if (lfuPart_->put(key, value))
+            lruPart_->remove(key);
         }
+        stats_.recordHit();
         return true;
       }
-      return lfuPart_->get(key, value);
-    }
 
-    // 读取缓存
-    Value get(Key key) override
-    {
-      Value value{};
-      get(key, value);
-      return value;
+      if (lfuPart_->get(key, value))
+      {
+        stats_.recordHit();
+        return true;
+      }
+      stats_.recordMiss();
+      return false;
     }
 
-  private:
     // 检查幽灵列表
     bool checkGhostCaches(Key key)
     {
@@ -86,13 +222,168 @@ namespace RainCache
         }
         inGhost = true;
       }
+
+      if (inGhost)
+        stats_.recordGhostHit();
       return inGhost;
     }
 
   private:
     size_t capacity_;
     size_t transformThreshold_;
+    mutable std::mutex mutex_; // 保证幽灵检查、容量调整和两部分之间的移动是一个整体
+    CacheStats stats_;         // 命中/淘汰/幽灵命中统计，需先于两部分构造
+    EvictionCallback<Key, Value> onEvict_; // 淘汰回调，为空时不调用
     std::unique_ptr<ArcLruPart<Key, Value>> lruPart_;
     std::unique_ptr<ArcLfuPart<Key, Value>> lfuPart_;
   };
-}
\ No newline at end of file
+
+  // Arc 分片优化，每个分片独立进行自适应调整
+  template <typename Key, typename Value>
+  class RainArcHash
+  {
+  public:
+    // sliceNum 默认使用系统的硬件并发数 std::thread::hardware_concurrency()
+    explicit RainArcHash(size_t capacity, int sliceNum, size_t transformThreshold = 2)
+        : capacity_(capacity),
+          sliceNum_(sliceNum > 0 ? sliceNum : std::thread::hardware_concurrency())
+    {
+      size_t sliceSize = std::ceil(capacity / static_cast<double>(sliceNum_)); // 获取每个分片的大小
+      for (int i = 0; i < sliceNum_; ++i)
+      {
+        arcSliceCaches_.emplace_back(new ArcSlice(sliceSize, transformThreshold));
+      }
+    }
+
+    // 存入缓存
+    void put(Key key, Value value)
+    {
+      size_t sliceIndex = Hash(key) % sliceNum_;
+      arcSliceCaches_[sliceIndex]->cache.put(key, value);
+    }
+
+    // 查询接口 1
+    bool get(Key key, Value &value)
+    {
+      size_t sliceIndex = Hash(key) % sliceNum_;
+      return arcSliceCaches_[sliceIndex]->cache.get(key, value);
+    }
+
+    // 查询接口 2
+    Value get(Key key)
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素
+    void remove(Key key)
+    {
+      arcSliceCaches_[Hash(key) % sliceNum_]->cache.remove(key);
+    }
+
+    // 批量存入：先按分片分组，每个分片整组只加一次锁
+    void putBatch(const std::vector<std::pair<Key, Value>> &entries)
+    {
+      std::vector<std::vector<std::pair<Key, Value>>> groups(sliceNum_);
+      for (const auto &entry : entries)
+      {
+        groups[Hash(entry.first) % sliceNum_].push_back(entry);
+      }
+
+      for (int i = 0; i < sliceNum_; ++i)
+      {
+        if (!groups[i].empty())
+          arcSliceCaches_[i]->cache.putBatch(groups[i]);
+      }
+    }
+
+    // 批量查询：values/found 与 keys 一一对应，返回命中数量
+    size_t getBatch(const std::vector<Key> &keys, std::vector<Value> &values, std::vector<bool> &found)
+    {
+      values.assign(keys.size(), Value{});
+      found.assign(keys.size(), false);
+
+      // 记录每个 key 在原始批次中的位置，查询完成后写回
+      std::vector<std::vector<size_t>> positions(sliceNum_);
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        positions[Hash(keys[i]) % sliceNum_].push_back(i);
+      }
+
+      size_t hits = 0;
+      std::vector<Key> sliceKeys;
+      std::vector<Value> sliceValues;
+      std::vector<bool> sliceFound;
+      for (int i = 0; i < sliceNum_; ++i)
+      {
+        if (positions[i].empty())
+          continue;
+
+        sliceKeys.clear();
+        for (size_t pos : positions[i])
+        {
+          sliceKeys.push_back(keys[pos]);
+        }
+
+        hits += arcSliceCaches_[i]->cache.getBatch(sliceKeys, sliceValues, sliceFound);
+        for (size_t j = 0; j < positions[i].size(); ++j)
+        {
+          if (sliceFound[j])
+          {
+            values[positions[i][j]] = sliceValues[j];
+            found[positions[i][j]] = true;
+          }
+        }
+      }
+      return hits;
+    }
+
+    // 当前驻留的不同 key 数量
+    size_t size() const
+    {
+      size_t total = 0;
+      for (const auto &slice : arcSliceCaches_)
+      {
+        total += slice->cache.size();
+      }
+      return total;
+    }
+
+    // 所有分片的统计汇总
+    CacheStatsSnapshot stats() const
+    {
+      CacheStatsSnapshot total;
+      for (const auto &slice : arcSliceCaches_)
+      {
+        total += slice->cache.stats();
+      }
+      return total;
+    }
+
+  private:
+    // 每个分片独占整数个缓存行，避免相邻分片的锁产生伪共享
+    struct alignas(64) ArcSlice
+    {
+      RainArc<Key, Value> cache;
+
+      ArcSlice(size_t capacity, size_t transformThreshold)
+          : cache(capacity, transformThreshold)
+      {
+      }
+    };
+
+    // 将key转换为对应hash值
+    size_t Hash(Key key)
+    {
+      std::hash<Key> hashFunc;
+      return hashFunc(key);
+    }
+
+  private:
+    size_t capacity_;                                     // 总容量
+    int sliceNum_;                                        // 切片数量
+    std::vector<std::unique_ptr<ArcSlice>> arcSliceCaches_; // 切片ARC缓存
+  };
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "RainCache.h"
+#include "RainArcCore.h"
+#include "RainSnapshot.h"
+#include "RainStaticIndex.h"
+#include "RainStats.h"
+
+namespace RainCache
+{
+  // 教科书式 ARC (Megiddo & Modha)
+  // T1：只访问过一次的数据，T2：访问过至少两次的数据
+  // B1/B2：分别记录从 T1/T2 淘汰的 key，p 为 T1 的自适应目标大小
+  // 自适应与替换决策在 ArcCore 中，与 StaticArc 共用；本类负责加锁、统计与快照
+  template <typename Key, typename Value>
+  class RainArcAdaptive : public RainCache<Key, Value>
+  {
+  private:
+    struct Entry
+    {
+      Key key;
+      Value value;
+      bool inT2; // 是否位于 T2
+    };
+
+  public:
+    using EntryList = std::list<Entry>;
+    using EntryIndex = HashIndex::Map<Key, typename EntryList::iterator, std::allocator<Entry>>;
+
+    explicit RainArcAdaptive(size_t capacity = 10)
+        : core_(capacity, std::allocator<Entry>(), capacity, std::allocator<Entry>())
+    {
+    }
+
+    ~RainArcAdaptive() override = default;
+
+    // 存入缓存
+    void put(Key key, Value value) override
+    {
+      if (core_.capacity() == 0)
+        return;
+
+      stats_.recordPut();
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto result = core_.put(key, value);
+      if (result.ghostHit)
+        stats_.recordGhostHit();
+      if (result.evicted)
+        stats_.recordEviction();
+    }
+
+    // 查询缓存，传出参数
+    bool get(Key key, Value &value) override
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!core_.get(key, value))
+      {
+        stats_.recordMiss();
+        return false;
+      }
+
+      stats_.recordHit();
+      return true;
+    }
+
+    // 查询缓存，返回值
+    Value get(Key key) override
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素，不进入幽灵列表，p 不变
+    void remove(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      core_.remove(key);
+    }
+
+    // 当前 T1 的目标大小
+    size_t target() const { return core_.target(); }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    // 保存快照到文件，包括自适应参数 p
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      SnapshotWriter out;
+      if (!out.open(path))
+        return false;
+      out.writeHeader(SnapshotPolicy::ArcAdaptive);
+      writeSnapshot<KeySerializer, ValueSerializer>(out);
+      return out.close();
+    }
+
+    // 从文件加载快照，替换当前全部内容；文件损坏或策略不符时返回 false
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path)
+    {
+      SnapshotReader in;
+      if (!in.open(path) || !in.readHeader(SnapshotPolicy::ArcAdaptive))
+        return false;
+      return readSnapshot<KeySerializer, ValueSerializer>(in);
+    }
+
+    // 写出 p 以及 T1、T2（不含文件头），列表均按从 LRU 到 MRU 的顺序
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      out.writePod<uint64_t>(core_.target());
+      for (const EntryList *list : {&core_.t1(), &core_.t2()})
+      {
+        out.writePod<uint64_t>(list->size());
+        for (auto it = list->rbegin(); it != list->rend(); ++it)
+        {
+          KeySerializer::write(out, it->key);
+          ValueSerializer::write(out, it->value);
+        }
+      }
+    }
+
+    // 读入 p 以及 T1、T2（不含文件头），B1/B2 不保存，加载后从空开始
+    // 先把条目读到临时缓冲，每个列表最多保留最近的 capacity 条，全部读完后才替换当前内容，失败时当前内容不变
+    // 快照来自更大的缓存时按 REPLACE 规则决定 T1/T2 各保留多少，裁掉的条目不进入幽灵列表，也不计入淘汰统计
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool readSnapshot(SnapshotReader &in)
+    {
+      uint64_t capacity = core_.capacity();
+      uint64_t p = 0;
+      if (!in.readPod(p))
+        return false;
+      std::vector<std::pair<Key, Value>> lists[2];
+      for (auto &list : lists)
+      {
+        uint64_t count = 0;
+        if (!in.readPod(count))
+          return false;
+        uint64_t skip = count > capacity ? count - capacity : 0;
+        list.reserve(count - skip);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+          Key key{};
+          Value value{};
+          if (!KeySerializer::read(in, key) || !ValueSerializer::read(in, value))
+            return false;
+          if (i >= skip)
+            list.emplace_back(std::move(key), std::move(value));
+        }
+      }
+
+      auto [keepT1, keepT2] = snapshotArcSplit(lists[0].size(), lists[1].size(), p, capacity);
+      std::lock_guard<std::mutex> lock(mutex_);
+      core_.clear();
+      for (bool inT2 : {false, true})
+      {
+        const auto &list = lists[inT2];
+        for (size_t i = list.size() - (inT2 ? keepT2 : keepT1); i < list.size(); ++i)
+        {
+          core_.restore(list[i].first, list[i].second, inT2);
+        }
+      }
+      core_.finishRestore(p);
+      return true;
+    }
+
+  private:
+    std::mutex mutex_;
+    ArcCore<Key, EntryList, EntryIndex> core_; // T1/T2/B1/B2 与 p
+    CacheStats stats_;                          // 命中/淘汰/幽灵命中统计
+  };
+} // namespace RainCache
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "RainArcGhost.h"
+
+namespace RainCache
+{
+  // ARC 的自适应与替换决策（Megiddo & Modha），由 RainArcAdaptive 与 StaticArc 共用
+  // EntryList 为 T1/T2 的链表类型，元素可由 {key, value, inT2} 构造，头部为 MRU
+  // EntryIndex 为 key 到链表位置的索引，接口与 RainStaticIndex.h 中的 Map 相同
+  // 本身不加锁、不记统计：put 返回这次是否幽灵命中、是否淘汰，由所属缓存加锁并计数
+  template <typename Key, typename EntryList, typename EntryIndex>
+  class ArcCore
+  {
+  public:
+    using Entry = typename EntryList::value_type;
+    using Value = decltype(Entry::value);
+    using EntryIter = typename EntryList::iterator;
+
+    // put 的结果，调用方据此记录统计
+    struct PutResult
+    {
+      bool ghostHit = false; // 命中 B1 或 B2
+      bool evicted = false;  // 淘汰了一个驻留 key
+    };
+
+    template <typename... IndexArgs>
+    ArcCore(size_t capacity, const typename EntryList::allocator_type &listAlloc, IndexArgs &&...indexArgs)
+        : capacity_(capacity),
+          p_(0),
+          t1_(listAlloc),
+          t2_(listAlloc),
+          index_(std::forward<IndexArgs>(indexArgs)...),
+          b1_(capacity),
+          b2_(2 * capacity)
+    {
+    }
+
+    // 命中时移到 T2 头部
+    bool get(const Key &key, Value &value)
+    {
+      EntryIter *pos = index_.find(key);
+      if (!pos)
+        return false;
+
+      promote(*pos);
+      value = (*pos)->value;
+      return true;
+    }
+
+    // 要求容量大于 0 且索引能放下该 key，由调用方检查
+    PutResult put(const Key &key, const Value &value)
+    {
+      PutResult result;
+      if (EntryIter *pos = index_.find(key))
+      {
+        // Case I：命中 T1/T2，更新值并移到 T2 头部
+        (*pos)->value = value;
+        promote(*pos);
+        return result;
+      }
+
+      if (b1_.contains(key))
+      {
+        // Case II：命中 B1，说明 T1 偏小，增大 p
+        result.ghostHit = true;
+        p_ = std::min(capacity_, p_ + std::max<size_t>(b2_.size() / b1_.size(), 1));
+        b1_.erase(key);
+        if (size() >= capacity_)
+          result.evicted = replace(false);
+        insertFront(t2_, key, value, true);
+        return result;
+      }
+
+      if (b2_.contains(key))
+      {
+        // Case III：命中 B2，说明 T2 偏小，减小 p
+        result.ghostHit = true;
+        size_t delta = std::max<size_t>(b1_.size() / b2_.size(), 1);
+        p_ = p_ > delta ? p_ - delta : 0;
+        b2_.erase(key);
+        if (size() >= capacity_)
+          result.evicted = replace(true);
+        insertFront(t2_, key, value, true);
+        return result;
+      }
+
+      // Case IV：完全未命中
+      if (t1_.size() + b1_.size() >= capacity_)
+      {
+        if (t1_.size() < capacity_)
+        {
+          b1_.popOldest();
+          if (size() >= capacity_)
+            result.evicted = replace(false);
+        }
+        else
+        {
+          // B1 为空且 T1 已满，直接丢弃 T1 尾部，不进入幽灵列表
+          index_.erase(t1_.back().key);
+          t1_.pop_back();
+          result.evicted = true;
+        }
+      }
+      else
+      {
+        size_t total = size() + b1_.size() + b2_.size();
+        if (total >= capacity_)
+        {
+          if (total >= 2 * capacity_)
+            b2_.popOldest();
+          if (size() >= capacity_)
+            result.evicted = replace(false);
+        }
+      }
+      insertFront(t1_, key, value, false);
+      return result;
+    }
+
+    // 删除驻留 key，不进入幽灵列表，p 不变
+    bool remove(const Key &key)
+    {
+      EntryIter *pos = index_.find(key);
+      if (!pos)
+        return false;
+
+      EntryIter entry = *pos;
+      index_.erase(key);
+      (entry->inT2 ? t2_ : t1_).erase(entry);
+      return true;
+    }
+
+    // 载入快照时使用：按 LRU 到 MRU 的顺序逐条调用，已存在的 key 忽略
+    void restore(const Key &key, const Value &value, bool inT2)
+    {
+      if (!index_.find(key))
+        insertFront(inT2 ? t2_ : t1_, key, value, inT2);
+    }
+
+    // 载入结束：设置 p 并清空幽灵列表，调用方保证载入的条目数不超过容量
+    void finishRestore(size_t p)
+    {
+      p_ = std::min(p, capacity_);
+      b1_.clear();
+      b2_.clear();
+    }
+
+    // 清空驻留数据与幽灵列表
+    void clear()
+    {
+      index_.clear();
+      t1_.clear();
+      t2_.clear();
+      b1_.clear();
+      b2_.clear();
+      p_ = 0;
+    }
+
+    bool contains(const Key &key) const { return index_.find(key) != nullptr; }
+    bool inBounds(const Key &key) const { return index_.inBounds(key); }
+    size_t size() const { return t1_.size() + t2_.size(); }
+    size_t capacity() const { return capacity_; }
+    size_t target() const { return p_; }
+    const EntryList &t1() const { return t1_; }
+    const EntryList &t2() const { return t2_; }
+
+  private:
+    // 插入到指定列表头部
+    void insertFront(EntryList &list, const Key &key, const Value &value, bool inT2)
+    {
+      list.push_front(Entry{key, value, inT2});
+      index_.insert(key, list.begin());
+    }
+
+    // 命中后移动到 T2 头部
+    void promote(EntryIter entry)
+    {
+      t2_.splice(t2_.begin(), entry->inT2 ? t2_ : t1_, entry);
+      entry->inT2 = true;
+    }
+
+    // REPLACE：根据 p 决定从 T1 还是 T2 淘汰，被淘汰的 key 进入对应的幽灵列表
+    bool replace(bool hitInB2)
+    {
+      bool fromT1 = !t1_.empty() &&
+                    (t1_.size() > p_ || (hitInB2 && t1_.size() == p_) || t2_.empty());
+      EntryList &victims = fromT1 ? t1_ : t2_;
+      if (victims.empty())
+        return false;
+
+      (fromT1 ? b1_ : b2_).push(victims.back().key);
+      index_.erase(victims.back().key);
+      victims.pop_back();
+      return true;
+    }
+
+  private:
+    size_t capacity_; // 缓存容量 c
+    size_t p_;        // T1 的目标大小
+    EntryList t1_;    // 最近只访问过一次
+    EntryList t2_;    // 最近访问过多次
+    EntryIndex index_; // key -> T1/T2 中的位置
+    ArcGhostList<Key> b1_; // |T1| + |B1| <= c
+    ArcGhostList<Key> b2_; // 四个列表合计 <= 2c
+  };
+} // namespace RainCache
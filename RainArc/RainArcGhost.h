@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace RainCache
+{
+  // ARC 幽灵列表：只记录被淘汰 key 的 32 位哈希指纹，不保存 key 和 value
+  // 指纹按淘汰先后写入环形缓冲，另有一个线性探测的指纹集合记录 指纹 -> 环形缓冲中的槽位；
+  // 命中时只从集合中删除，环形缓冲里留下的旧槽位在出队或重建时跳过
+  // 两者都随有效指纹数伸缩，容量上限在构造时给定；每个幽灵摊到环形缓冲 6~12 字节、
+  // 指纹集合 11~21 字节，与 key 和 value 的大小无关
+  // 指纹冲突只会产生一次误判的幽灵命中，不影响缓存数据的正确性
+  template <typename Key, typename Hash = std::hash<Key>>
+  class ArcGhostList
+  {
+  public:
+    using Fingerprint = uint32_t;
+
+    // capacity 为最多记录的指纹数，满了以后再 push 会丢弃最早的一条
+    explicit ArcGhostList(size_t capacity) : capacity_(capacity) {}
+
+    // 是否在幽灵列表中
+    bool contains(const Key &key) const
+    {
+      return findSlot(fingerprint(key)) != kNotFound;
+    }
+
+    // 从幽灵列表中删除，命中返回 true
+    bool erase(const Key &key)
+    {
+      size_t slot = findSlot(fingerprint(key));
+      if (slot == kNotFound)
+        return false;
+
+      eraseSlot(slot);
+      return true;
+    }
+
+    // 记录一个刚被淘汰的 key
+    void push(const Key &key)
+    {
+      if (capacity_ == 0)
+        return;
+
+      Fingerprint fp = fingerprint(key);
+      size_t slot = findSlot(fp);
+      if (slot != kNotFound)
+        eraseSlot(slot);
+      else if (size_ == capacity_)
+        popOldest();
+
+      if (tail_ - head_ == ring_.size())
+        rebuildRing();
+      if ((size_ + 1) * 4 > set_.size() * 3)
+        rehashSet(set_.empty() ? 8 : set_.size() * 2);
+
+      uint32_t pos = static_cast<uint32_t>(tail_ & (ring_.size() - 1));
+      ring_[pos] = fp;
+      ++tail_;
+      insertSlot({fp, pos});
+    }
+
+    // 丢弃最早淘汰的 key
+    bool popOldest()
+    {
+      while (head_ != tail_)
+      {
+        uint32_t pos = static_cast<uint32_t>(head_ & (ring_.size() - 1));
+        ++head_;
+
+        // 集合中该指纹仍指向这个槽位才是有效记录，否则是已被命中或重新淘汰的旧记录
+        size_t slot = findSlot(ring_[pos]);
+        if (slot != kNotFound && set_[slot].pos == pos)
+        {
+          eraseSlot(slot);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // 环形缓冲与指纹集合占用的字节数
+    size_t memoryBytes() const
+    {
+      return ring_.capacity() * sizeof(Fingerprint) + set_.capacity() * sizeof(SetSlot);
+    }
+
+    // 清空幽灵列表并释放内存
+    void clear()
+    {
+      std::vector<Fingerprint>().swap(ring_);
+      std::vector<SetSlot>().swap(set_);
+      head_ = 0;
+      tail_ = 0;
+      size_ = 0;
+    }
+
+  private:
+    // 指纹集合的槽位，fp 为 0 表示空槽
+    struct SetSlot
+    {
+      Fingerprint fp;
+      uint32_t pos; // 在环形缓冲中的下标
+    };
+
+    static constexpr size_t kNotFound = SIZE_MAX;
+
+    // 计算 key 的指纹，先做一次完整的 64 位混合避免整数 key 的恒等哈希，取高 32 位；0 留给空槽
+    Fingerprint fingerprint(const Key &key) const
+    {
+      uint64_t h = static_cast<uint64_t>(Hash{}(key));
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      Fingerprint fp = static_cast<Fingerprint>(h >> 32);
+      return fp == 0 ? 1 : fp;
+    }
+
+    // 指纹已经过混合，直接取低位作为理想槽位
+    size_t homeSlot(Fingerprint fp) const { return fp & (set_.size() - 1); }
+
+    size_t findSlot(Fingerprint fp) const
+    {
+      if (set_.empty())
+        return kNotFound;
+
+      size_t mask = set_.size() - 1;
+      for (size_t i = homeSlot(fp);; i = (i + 1) & mask)
+      {
+        if (set_[i].fp == fp)
+          return i;
+        if (set_[i].fp == 0)
+          return kNotFound;
+      }
+    }
+
+    void insertSlot(SetSlot entry)
+    {
+      size_t mask = set_.size() - 1;
+      size_t i = homeSlot(entry.fp);
+      while (set_[i].fp != 0)
+      {
+        i = (i + 1) & mask;
+      }
+      set_[i] = entry;
+      ++size_;
+    }
+
+    // 线性探测的后移删除，不留墓碑
+    void eraseSlot(size_t slot)
+    {
+      size_t mask = set_.size() - 1;
+      size_t hole = slot;
+      for (size_t i = (slot + 1) & mask; set_[i].fp != 0; i = (i + 1) & mask)
+      {
+        // 理想槽位不在 (hole, i] 之间的元素可以前移到空洞
+        size_t home = homeSlot(set_[i].fp);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+          set_[hole] = set_[i];
+          hole = i;
+        }
+      }
+      set_[hole] = {0, 0};
+      --size_;
+    }
+
+    void rehashSet(size_t slots)
+    {
+      std::vector<SetSlot> old(slots, SetSlot{0, 0});
+      old.swap(set_);
+      size_ = 0;
+      for (const SetSlot &entry : old)
+      {
+        if (entry.fp != 0)
+          insertSlot(entry);
+      }
+    }
+
+    // 环形缓冲写满时按淘汰顺序只保留有效记录，大小调整为有效记录数的 1.5~3 倍，
+    // 之后至少空出三分之一的槽位，重建的开销摊到每次 push 上是常数
+    void rebuildRing()
+    {
+      std::vector<Fingerprint> ring(std::bit_ceil(std::max<size_t>(size_ + size_ / 2 + 1, 8)));
+      uint32_t count = 0;
+      for (uint64_t i = head_; i != tail_; ++i)
+      {
+        uint32_t pos = static_cast<uint32_t>(i & (ring_.size() - 1));
+        size_t slot = findSlot(ring_[pos]);
+        if (slot != kNotFound && set_[slot].pos == pos)
+          ring[count++] = ring_[pos];
+      }
+      // 全部拷贝完再改槽位，避免新下标与后面旧记录的下标相同而被误认成有效记录
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        set_[findSlot(ring[i])].pos = i;
+      }
+      ring_.swap(ring);
+      head_ = 0;
+      tail_ = count;
+    }
+
+  private:
+    size_t capacity_;               // 最多记录的指纹数
+    std::vector<Fingerprint> ring_; // 按淘汰顺序的指纹，大小为 2 的幂
+    std::vector<SetSlot> set_;      // 指纹 -> 槽位，线性探测，大小为 2 的幂
+    uint64_t head_ = 0;             // 最早记录的序号
+    uint64_t tail_ = 0;             // 下一条记录的序号
+    size_t size_ = 0;               // 有效指纹数
+  };
+} // namespace RainCache
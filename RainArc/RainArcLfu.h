@@ -1,7 +1,13 @@
 #pragma once
 
+#include "RainCache.h"
 #include "RainArcNode.h"
+#include "RainArcGhost.h"
+#include "RainSnapshot.h"
+#include "RainStats.h"
+#include <algorithm>
 #include <unordered_map>
+#include <list>
 #include <map>
 #include <mutex>
 
@@ -15,12 +21,15 @@ namespace RainCache
     using NodePtr = std::shared_ptr<NodeType>;
     using NodeMap = std::unordered_map<Key, NodePtr>;
     using FreqMap = std::map<size_t, std::list<NodePtr>>;
+    using ListPos = typename std::list<NodePtr>::iterator;
 
     // 构造函数
-    explicit ArcLfuPart(size_t capacity, size_t transformThreshold)
-        : capacity_(capacity), ghostCapacity_(capacity), transformThreshold_(transformThreshold), minFreq_(0)
+    // stats 由 RainArc 传入，用于记录淘汰次数；onEvict 为 RainArc 的淘汰回调，可为空
+    explicit ArcLfuPart(size_t capacity, size_t transformThreshold, CacheStats *stats = nullptr,
+                        const EvictionCallback<Key, Value> *onEvict = nullptr)
+        : capacity_(capacity), ghostCapacity_(capacity), transformThreshold_(transformThreshold), minFreq_(0), stats_(stats),
+          onEvict_(onEvict), ghost_(capacity)
     {
-      initializeLists();
     }
 
     // 添加缓存
@@ -52,17 +61,65 @@ namespace RainCache
       return false;
     }
 
+    // 是否在主缓存中
+    bool contains(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return mainCache_.find(key) != mainCache_.end();
+    }
+
+    // 移出主缓存，不进入幽灵列表
+    bool remove(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = mainCache_.find(key);
+      if (it == mainCache_.end())
+        return false;
+
+      size_t freq = it->second->getAccessCount();
+      auto &list = freqMap_[freq];
+      list.erase(listPos_[key]);
+      if (list.empty())
+      {
+        freqMap_.erase(freq);
+        minFreq_ = freqMap_.empty() ? 0 : freqMap_.begin()->first;
+      }
+      listPos_.erase(key);
+      mainCache_.erase(it);
+      return true;
+    }
+
+    // 当前驻留数量
+    size_t size()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return mainCache_.size();
+    }
+
     // 检查幽灵列表
     bool checkGhost(Key key)
     {
-      auto it = ghostCache_.find(key);
-      if (it != ghostCache_.end())
+      return ghost_.erase(key);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    // 重设容量，超出部分从频率最低的一端直接丢弃，不进入幽灵列表，也不触发回调与统计（加载快照时使用）
+    void resetCapacity(size_t capacity)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      capacity_ = capacity;
+      while (mainCache_.size() > capacity_)
       {
-        removeFromGhost(it->second);
-        ghostCache_.erase(it);
-        return true;
+        auto it = freqMap_.begin();
+        NodePtr leastNode = it->second.front();
+        it->second.pop_front();
+        if (it->second.empty())
+          freqMap_.erase(it);
+        listPos_.erase(leastNode->getKey());
+        mainCache_.erase(leastNode->getKey());
       }
-      return false;
+      minFreq_ = freqMap_.empty() ? 0 : freqMap_.begin()->first;
     }
 
     // 增加容量
@@ -81,14 +138,74 @@ namespace RainCache
       return true;
     }
 
+    // 写出容量与主缓存条目，按频率从低到高、同频率按先后顺序，每条为 (accessCount, key, value)
+    template <typename KeySerializer, typename ValueSerializer>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      out.writePod<uint64_t>(capacity_);
+      out.writePod<uint64_t>(mainCache_.size());
+      for (const auto &entry : freqMap_)
+      {
+        for (const NodePtr &node : entry.second)
+        {
+          out.writePod<uint64_t>(node->accessCount_);
+          KeySerializer::write(out, node->key_);
+          ValueSerializer::write(out, node->value_);
+        }
+      }
+    }
+
+    // 读入保存时的容量与条目，保留原有访问频率，幽灵列表从空开始
+    // 保存时的容量只用于恢复两部分的划分比例，由 RainArc 随后按自身容量 resetCapacity
+    // 最多保留 limit 条（加载方两部分容量之和），超出时丢弃开头频率最低的部分，文件中的条目数不决定分配大小
+    template <typename KeySerializer, typename ValueSerializer>
+    bool readSnapshot(SnapshotReader &in, uint64_t limit)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      clearMain();
+      ghost_.clear();
+
+      uint64_t capacity = 0;
+      uint64_t count = 0;
+      if (!in.readPod(capacity) || !in.readPod(count))
+        return false;
+      capacity_ = capacity;
+      uint64_t keep = std::min(capacity, limit);
+      uint64_t skip = count > keep ? count - keep : 0;
+      mainCache_.reserve(count - skip);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        uint64_t accessCount = 0;
+        Key key{};
+        Value value{};
+        if (!in.readPod(accessCount) || !KeySerializer::read(in, key) || !ValueSerializer::read(in, value))
+        {
+          clearMain();
+          return false;
+        }
+        if (i < skip || mainCache_.count(key))
+          continue;
+
+        NodePtr node = std::make_shared<NodeType>(key, value);
+        node->accessCount_ = std::max<uint64_t>(accessCount, 1);
+        mainCache_[key] = node;
+        auto &list = freqMap_[node->accessCount_];
+        list.push_back(node);
+        listPos_[key] = std::prev(list.end());
+      }
+      minFreq_ = freqMap_.empty() ? 0 : freqMap_.begin()->first;
+      return true;
+    }
+
   private:
-    // 初始化列表
-    void initializeLists()
+    // 清空主缓存
+    void clearMain()
     {
-      ghostHead_ = std::make_shared<NodeType>();
-      ghostTail_ = std::make_shared<NodeType>();
-      ghostHead_->next_ = ghostTail_;
-      ghostTail_->prev_ = ghostHead_;
+      freqMap_.clear();
+      listPos_.clear();
+      mainCache_.clear();
+      minFreq_ = 0;
     }
 
     // 更新已存在的节点值
@@ -116,6 +233,7 @@ namespace RainCache
         freqMap_[1] = std::list<NodePtr>();
       }
       freqMap_[1].push_back(newNode);
+      listPos_[key] = std::prev(freqMap_[1].end());
       minFreq_ = 1;
 
       return true;
@@ -128,9 +246,10 @@ namespace RainCache
       node->incrementAccessCount();
       size_t newFreq = node->getAccessCount();
 
-      // 从旧频率列表中移除
+      // 从旧频率列表摘下节点并接到新频率列表尾部，splice 之后记录的迭代器仍然有效
       auto &oldList = freqMap_[oldFreq];
-      oldList.remove(node);
+      auto &newList = freqMap_[newFreq];
+      newList.splice(newList.end(), oldList, listPos_[node->getKey()]);
       if (oldList.empty())
       {
         freqMap_.erase(oldFreq);
@@ -139,13 +258,6 @@ namespace RainCache
           minFreq_ = newFreq;
         }
       }
-
-      // 添加到新频率列表
-      if (freqMap_.find(newFreq) == freqMap_.end())
-      {
-        freqMap_[newFreq] = std::list<NodePtr>();
-      }
-      freqMap_[newFreq].push_back(node);
     }
 
     // 从主缓存中驱逐最低频率
@@ -174,65 +286,34 @@ namespace RainCache
         }
       }
 
-      // 将节点移到幽灵缓存
-      if (ghostCache_.size() >= ghostCapacity_)
+      // 将节点的 key 指纹移到幽灵缓存
+      if (ghost_.size() >= ghostCapacity_)
       {
-        removeOldestGhost();
+        ghost_.popOldest();
       }
-      addToGhost(leastNode);
+      ghost_.push(leastNode->getKey());
+      if (stats_)
+        stats_->recordEviction();
+      if (onEvict_ && *onEvict_)
+        (*onEvict_)(leastNode->key_, leastNode->value_);
 
       // 从主缓存中移除
+      listPos_.erase(leastNode->getKey());
       mainCache_.erase(leastNode->getKey());
     }
 
-    // 从幽灵列表中移除数据
-    void removeFromGhost(NodePtr node)
-    {
-      if (!node->prev_.expired() && node->next_)
-      {
-        auto prev = node->prev_.lock();
-        prev->next_ = node->next_;
-        node->next_->prev_ = node->prev_;
-        node->next_ = nullptr; // 清空指针，防止悬垂引用
-      }
-    }
-
-    // 添加数据到幽灵列表
-    void addToGhost(NodePtr node)
-    {
-      node->next_ = ghostTail_;
-      node->prev_ = ghostTail_->prev_;
-      if (!ghostTail_->prev_.expired())
-      {
-        ghostTail_->prev_.lock()->next_ = node;
-      }
-      ghostTail_->prev_ = node;
-      ghostCache_[node->getKey()] = node;
-    }
-
-    // 移除幽灵列表尾部数据
-    void removeOldestGhost()
-    {
-      NodePtr oldestGhost = ghostHead_->next_;
-      if (oldestGhost != ghostTail_)
-      {
-        removeFromGhost(oldestGhost);
-        ghostCache_.erase(oldestGhost->getKey());
-      }
-    }
-
   private:
     size_t capacity_;
     size_t ghostCapacity_;
     size_t transformThreshold_;
     size_t minFreq_;
+    CacheStats *stats_; // 所属 RainArc 的统计，可为空
+    const EvictionCallback<Key, Value> *onEvict_; // 所属 RainArc 的淘汰回调，可为空
     std::mutex mutex_;
 
     NodeMap mainCache_;
-    NodeMap ghostCache_;
+    std::unordered_map<Key, ListPos> listPos_; // key -> 在所属频率列表中的位置
+    ArcGhostList<Key> ghost_; // 淘汰 key 的指纹
     FreqMap freqMap_;
-
-    NodePtr ghostHead_;
-    NodePtr ghostTail_;
   };
 }
\ No newline at end of file
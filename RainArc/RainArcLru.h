@@ -1,6 +1,11 @@
 #pragma once
 
+#include "RainCache.h"
 #include "RainArcNode.h"
+#include "RainArcGhost.h"
+#include "RainSnapshot.h"
+#include "RainStats.h"
+#include <algorithm>
 #include <unordered_map>
 #include <mutex>
 
@@ -15,14 +20,21 @@ namespace RainCache
     using NodeMap = std::unordered_map<Key, NodePtr>;
 
     // 构造函数
-    explicit ArcLruPart(size_t capacity, size_t transformThreshold)
+    // stats 由 RainArc 传入，用于记录淘汰次数；onEvict 为 RainArc 的淘汰回调，可为空
+    explicit ArcLruPart(size_t capacity, size_t transformThreshold, CacheStats *stats = nullptr,
+                        const EvictionCallback<Key, Value> *onEvict = nullptr)
         : capacity_(capacity),
           ghostCapacity_(capacity),
-          transformThreshold_(transformThreshold)
+          transformThreshold_(transformThreshold),
+          stats_(stats),
+          onEvict_(onEvict),
+          ghost_(capacity)
     {
       initializeLists();
     }
 
+    ~ArcLruPart() { clearMain(); }
+
     // 存入缓存
     bool put(Key key, Value value)
     {
@@ -52,17 +64,45 @@ namespace RainCache
       return false;
     }
 
+    // 移出主缓存（晋升到 LFU 部分或删除时使用），不进入幽灵列表
+    bool remove(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = mainCache_.find(key);
+      if (it == mainCache_.end())
+        return false;
+
+      removeFromMain(it->second);
+      mainCache_.erase(it);
+      return true;
+    }
+
+    // 当前驻留数量
+    size_t size()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return mainCache_.size();
+    }
+
     // 查询幽灵
     bool checkGhost(Key key)
     {
-      auto it = ghostCache_.find(key);
-      if (it != ghostCache_.end())
+      return ghost_.erase(key);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    // 重设容量，超出部分从最旧的一端直接丢弃，不进入幽灵列表，也不触发回调与统计（加载快照时使用）
+    void resetCapacity(size_t capacity)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      capacity_ = capacity;
+      while (mainCache_.size() > capacity_)
       {
-        removeFromGhost(it->second);
-        ghostCache_.erase(it);
-        return true;
+        NodePtr oldest = mainTail_->prev_.lock();
+        removeFromMain(oldest);
+        mainCache_.erase(oldest->getKey());
       }
-      return false;
     }
 
     // 增加 Lru 容量
@@ -84,7 +124,77 @@ namespace RainCache
       return true;
     }
 
+    // 写出容量与主缓存条目，按从旧到新的顺序，每条为 (accessCount, key, value)
+    template <typename KeySerializer, typename ValueSerializer>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      out.writePod<uint64_t>(capacity_);
+      out.writePod<uint64_t>(mainCache_.size());
+      for (NodePtr node = mainTail_->prev_.lock(); node != mainHead_; node = node->prev_.lock())
+      {
+        out.writePod<uint64_t>(node->accessCount_);
+        KeySerializer::write(out, node->key_);
+        ValueSerializer::write(out, node->value_);
+      }
+    }
+
+    // 读入保存时的容量与条目，依次插到头部即可恢复 LRU 顺序，幽灵列表从空开始
+    // 保存时的容量只用于恢复两部分的划分比例，由 RainArc 随后按自身容量 resetCapacity
+    // 最多保留 limit 条（加载方两部分容量之和），超出时丢弃开头最旧的部分，文件中的条目数不决定分配大小；
+    // 直接插入，不经过淘汰，不产生幽灵、回调与统计
+    template <typename KeySerializer, typename ValueSerializer>
+    bool readSnapshot(SnapshotReader &in, uint64_t limit)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      clearMain();
+      ghost_.clear();
+
+      uint64_t capacity = 0;
+      uint64_t count = 0;
+      if (!in.readPod(capacity) || !in.readPod(count))
+        return false;
+      capacity_ = capacity;
+      uint64_t keep = std::min(capacity, limit);
+      uint64_t skip = count > keep ? count - keep : 0;
+      mainCache_.reserve(count - skip);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        uint64_t accessCount = 0;
+        Key key{};
+        Value value{};
+        if (!in.readPod(accessCount) || !KeySerializer::read(in, key) || !ValueSerializer::read(in, value))
+        {
+          clearMain();
+          return false;
+        }
+        if (i < skip || mainCache_.count(key))
+          continue;
+
+        NodePtr node = std::make_shared<NodeType>(key, value);
+        node->accessCount_ = accessCount;
+        mainCache_[key] = node;
+        addToFront(node);
+      }
+      return true;
+    }
+
   private:
+    // 逐个断开主链表节点后清空，避免 shared_ptr 链在析构时递归过深导致栈溢出
+    void clearMain()
+    {
+      NodePtr node = mainHead_->next_;
+      while (node && node != mainTail_)
+      {
+        NodePtr next = node->next_;
+        node->next_ = nullptr;
+        node = next;
+      }
+      mainHead_->next_ = mainTail_;
+      mainTail_->prev_ = mainHead_;
+      mainCache_.clear();
+    }
+
     // 初始化 Lru 链表
     void initializeLists()
     {
@@ -92,11 +202,6 @@ namespace RainCache
       mainTail_ = std::make_shared<NodeType>();
       mainHead_->next_ = mainTail_;
       mainTail_->prev_ = mainHead_;
-
-      ghostHead_ = std::make_shared<NodeType>();
-      ghostTail_ = std::make_shared<NodeType>();
-      ghostHead_->next_ = ghostTail_;
-      ghostTail_->prev_ = ghostHead_;
     }
 
     // 存在缓存里的节点，更新数值
@@ -164,12 +269,16 @@ namespace RainCache
       // 从主链表中移除
       removeFromMain(leastRecent);
 
-      // 添加到幽灵缓存
-      if (ghostCache_.size() >= ghostCapacity_)
+      // 添加到幽灵缓存，只记录 key 的指纹，value 随节点一起释放
+      if (ghost_.size() >= ghostCapacity_)
       {
-        removeOldestGhost();
+        ghost_.popOldest();
       }
-      addToGhost(leastRecent);
+      ghost_.push(leastRecent->getKey());
+      if (stats_)
+        stats_->recordEviction();
+      if (onEvict_ && *onEvict_)
+        (*onEvict_)(leastRecent->key_, leastRecent->value_);
 
       // 从主缓存映射中移除
       mainCache_.erase(leastRecent->getKey());
@@ -187,60 +296,19 @@ namespace RainCache
       }
     }
 
-    // 从幽灵链表中删除
-    void removeFromGhost(NodePtr node)
-    {
-      if (!node->prev_.expired() && node->next_)
-      {
-        auto prev = node->prev_.lock();
-        prev->next_ = node->next_;
-        node->next_->prev_ = node->prev_;
-        node->next_ = nullptr; // 清空指针，防止悬垂引用
-      }
-    }
-
-    // 添加到幽灵链表中
-    void addToGhost(NodePtr node)
-    {
-      // 重置节点的访问计数
-      node->accessCount_ = 1;
-
-      // 添加到幽灵缓存的头部
-      node->next_ = ghostHead_->next_;
-      node->prev_ = ghostHead_;
-      ghostHead_->next_->prev_ = node;
-      ghostHead_->next_ = node;
-
-      // 添加到幽灵缓存映射
-      ghostCache_[node->getKey()] = node;
-    }
-
-    // 移除幽灵链表尾部
-    void removeOldestGhost()
-    {
-      // 使用lock()方法，并添加null检查
-      NodePtr oldestGhost = ghostTail_->prev_.lock();
-      if (!oldestGhost || oldestGhost == ghostHead_)
-        return;
-
-      removeFromGhost(oldestGhost);
-      ghostCache_.erase(oldestGhost->getKey());
-    }
-
   private:
     size_t capacity_;
     size_t ghostCapacity_;
     size_t transformThreshold_; // 转换门槛值
+    CacheStats *stats_;         // 所属 RainArc 的统计，可为空
+    const EvictionCallback<Key, Value> *onEvict_; // 所属 RainArc 的淘汰回调，可为空
     std::mutex mutex_;
 
-    NodeMap mainCache_; // key -> ArcNode
-    NodeMap ghostCache_;
+    NodeMap mainCache_;       // key -> ArcNode
+    ArcGhostList<Key> ghost_; // 淘汰 key 的指纹
 
     // 主链表
     NodePtr mainHead_;
     NodePtr mainTail_;
-    // 淘汰链表
-    NodePtr ghostHead_;
-    NodePtr ghostTail_;
   };
 }
\ No newline at end of file
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "RainCache.h"
+#include "RainArcGhost.h"
+#include "RainSnapshot.h"
+#include "RainStats.h"
+
+namespace RainCache
+{
+  // CAR (Clock with Adaptive Replacement, Bansal & Modha)
+  // T1/T2 改为两个时钟，命中只需置位引用位，不再移动链表节点
+  // 因此 get 只持有共享锁，多个读线程可以同时命中
+  template <typename Key, typename Value>
+  class RainCar : public RainCache<Key, Value>
+  {
+  private:
+    struct Entry
+    {
+      Key key;
+      Value value;
+      std::atomic<bool> referenced; // 时钟引用位
+      bool inT2;                    // 是否位于 T2
+
+      Entry(const Key &k, const Value &v)
+          : key(k), value(v), referenced(false), inT2(false)
+      {
+      }
+    };
+
+  public:
+    using EntryList = std::list<Entry>;
+    using EntryMap = std::unordered_map<Key, typename EntryList::iterator>;
+
+    explicit RainCar(size_t capacity = 10)
+        : capacity_(capacity),
+          p_(0),
+          b1_(capacity),
+          b2_(2 * capacity)
+    {
+    }
+
+    ~RainCar() override = default;
+
+    // 存入缓存
+    void put(Key key, Value value) override
+    {
+      if (capacity_ == 0)
+        return;
+
+      stats_.recordPut();
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      auto it = mainCache_.find(key);
+      if (it != mainCache_.end())
+      {
+        it->second->value = value;
+        it->second->referenced.store(true, std::memory_order_relaxed);
+        return;
+      }
+
+      bool inB1 = b1_.contains(key);
+      bool inB2 = !inB1 && b2_.contains(key);
+      if (inB1 || inB2)
+        stats_.recordGhostHit();
+
+      if (mainCache_.size() >= capacity_)
+      {
+        replace();
+
+        // 控制幽灵列表大小：|T1|+|B1| <= c，总大小 <= 2c
+        if (!inB1 && !inB2)
+        {
+          if (t1_.size() + b1_.size() >= capacity_)
+            b1_.popOldest();
+          else if (mainCache_.size() + b1_.size() + b2_.size() >= 2 * capacity_)
+            b2_.popOldest();
+        }
+      }
+
+      if (inB1)
+      {
+        // 命中 B1，增大 T1 的目标大小
+        p_ = std::min(capacity_, p_ + std::max<size_t>(b2_.size() / b1_.size(), 1));
+        b1_.erase(key);
+        insertTail(t2_, key, value, true);
+      }
+      else if (inB2)
+      {
+        // 命中 B2，减小 T1 的目标大小
+        size_t delta = std::max<size_t>(b1_.size() / b2_.size(), 1);
+        p_ = p_ > delta ? p_ - delta : 0;
+        b2_.erase(key);
+        insertTail(t2_, key, value, true);
+      }
+      else
+      {
+        insertTail(t1_, key, value, false);
+      }
+    }
+
+    // 查询缓存，传出参数，命中只置位引用位
+    bool get(Key key, Value &value) override
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto it = mainCache_.find(key);
+      if (it == mainCache_.end())
+      {
+        stats_.recordMiss();
+        return false;
+      }
+
+      it->second->referenced.store(true, std::memory_order_relaxed);
+      value = it->second->value;
+      stats_.recordHit();
+      return true;
+    }
+
+    // 查询缓存，返回值
+    Value get(Key key) override
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素，不进入幽灵列表，p 不变
+    void remove(Key key)
+    {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      auto it = mainCache_.find(key);
+      if (it == mainCache_.end())
+        return;
+
+      (it->second->inT2 ? t2_ : t1_).erase(it->second);
+      mainCache_.erase(it);
+    }
+
+    // 当前 T1 的目标大小
+    size_t target() const { return p_; }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    // 保存快照到文件，包括自适应参数 p 与引用位
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      SnapshotWriter out;
+      if (!out.open(path))
+        return false;
+      out.writeHeader(SnapshotPolicy::Car);
+      writeSnapshot<KeySerializer, ValueSerializer>(out);
+      return out.close();
+    }
+
+    // 从文件加载快照，替换当前全部内容；文件损坏或策略不符时返回 false
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path)
+    {
+      SnapshotReader in;
+      if (!in.open(path) || !in.readHeader(SnapshotPolicy::Car))
+        return false;
+      return readSnapshot<KeySerializer, ValueSerializer>(in);
+    }
+
+    // 写出 p 以及两个时钟（不含文件头），时钟从指针处开始，每条为 (referenced, key, value)
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      out.writePod<uint64_t>(p_);
+      for (const EntryList *clock : {&t1_, &t2_})
+      {
+        out.writePod<uint64_t>(clock->size());
+        for (const Entry &entry : *clock)
+        {
+          out.writePod<uint8_t>(entry.referenced.load(std::memory_order_relaxed) ? 1 : 0);
+          KeySerializer::write(out, entry.key);
+          ValueSerializer::write(out, entry.value);
+        }
+      }
+    }
+
+    // 读入 p 以及两个时钟（不含文件头），B1/B2 不保存，加载后从空开始
+    // 先把条目读到临时缓冲，每个时钟最多保留离指针最远的 capacity 条，全部读完后才替换当前内容，失败时当前内容不变
+    // 快照来自更大的缓存时按 REPLACE 规则决定 T1/T2 各保留多少，从指针一侧丢弃，不转动时钟，
+    // 裁掉的 key 不进入幽灵列表，也不计入淘汰统计
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool readSnapshot(SnapshotReader &in)
+    {
+      struct Loaded
+      {
+        bool referenced;
+        Key key;
+        Value value;
+      };
+
+      uint64_t p = 0;
+      if (!in.readPod(p))
+        return false;
+      std::vector<Loaded> clocks[2];
+      for (auto &clock : clocks)
+      {
+        uint64_t count = 0;
+        if (!in.readPod(count))
+          return false;
+        uint64_t skip = count > capacity_ ? count - capacity_ : 0;
+        clock.reserve(count - skip);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+          uint8_t referenced = 0;
+          Key key{};
+          Value value{};
+          if (!in.readPod(referenced) || !KeySerializer::read(in, key) || !ValueSerializer::read(in, value))
+            return false;
+          if (i >= skip)
+            clock.push_back({referenced != 0, std::move(key), std::move(value)});
+        }
+      }
+
+      auto [keepT1, keepT2] = snapshotArcSplit(clocks[0].size(), clocks[1].size(), p, capacity_);
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      clearInternal();
+      for (bool inT2 : {false, true})
+      {
+        const auto &clock = clocks[inT2];
+        for (size_t i = clock.size() - (inT2 ? keepT2 : keepT1); i < clock.size(); ++i)
+        {
+          if (mainCache_.count(clock[i].key))
+            continue;
+          insertTail(inT2 ? t2_ : t1_, clock[i].key, clock[i].value, inT2);
+          mainCache_[clock[i].key]->referenced.store(clock[i].referenced, std::memory_order_relaxed);
+        }
+      }
+      p_ = std::min<uint64_t>(p, capacity_);
+      return true;
+    }
+
+  private:
+    // 清空驻留数据与幽灵列表
+    void clearInternal()
+    {
+      mainCache_.clear();
+      t1_.clear();
+      t2_.clear();
+      b1_.clear();
+      b2_.clear();
+      p_ = 0;
+    }
+
+    // 插入到时钟尾部（即指针的前一个位置）
+    void insertTail(EntryList &clock, const Key &key, const Value &value, bool inT2)
+    {
+      clock.emplace_back(key, value);
+      clock.back().inT2 = inT2;
+      mainCache_[key] = std::prev(clock.end());
+    }
+
+    // 转动时钟直到找到一个引用位为 0 的节点并将其淘汰
+    void replace()
+    {
+      while (!mainCache_.empty())
+      {
+        bool fromT1 = !t1_.empty() && (t1_.size() >= std::max<size_t>(p_, 1) || t2_.empty());
+        EntryList &clock = fromT1 ? t1_ : t2_;
+        auto head = clock.begin();
+
+        if (!head->referenced.load(std::memory_order_relaxed))
+        {
+          (fromT1 ? b1_ : b2_).push(head->key);
+          mainCache_.erase(head->key);
+          clock.pop_front();
+          stats_.recordEviction();
+          return;
+        }
+
+        // 引用位为 1：清零并放到 T2 尾部（T1 中的节点借此晋升）
+        head->referenced.store(false, std::memory_order_relaxed);
+        head->inT2 = true;
+        t2_.splice(t2_.end(), clock, head);
+      }
+    }
+
+  private:
+    size_t capacity_; // 缓存容量 c
+    size_t p_;        // T1 的目标大小
+    std::shared_mutex mutex_;
+
+    EntryMap mainCache_; // key -> T1/T2 中的位置
+    EntryList t1_;       // 时钟 1，头部为时钟指针
+    EntryList t2_;       // 时钟 2，头部为时钟指针
+    ArcGhostList<Key> b1_; // |T1| + |B1| <= c
+    ArcGhostList<Key> b2_; // 四个列表合计 <= 2c
+    CacheStats stats_; // 命中/淘汰/幽灵命中统计
+  };
+} // namespace RainCache
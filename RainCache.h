@@ -1,7 +1,14 @@
 #pragma once
 
+#include <functional>
+
 namespace RainCache
 {
+  // 淘汰回调：条目因容量不足被淘汰时以 (key, value) 调用
+  // 调用时持有缓存内部的锁，回调中不能再访问同一个缓存
+  template <typename Key, typename Value>
+  using EvictionCallback = std::function<void(const Key &, const Value &)>;
+
   template <typename Key, typename Value>
   class RainCache
   {
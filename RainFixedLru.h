@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace RainCache
+{
+  // 定长 LRU：容量 N 是模板参数，全部存储在对象内部的 std::array 中，不申请堆内存、不加锁、没有虚函数
+  // 用于每个请求或每个线程独占的小型记忆化缓存（几到几十个条目），构造只是清零几个数组
+  // 条目紧凑存放在 [0, size) 内，查找为线性扫描；每个条目记录最后访问的时间戳，满时淘汰时间戳最小者
+  template <typename Key, typename Value, size_t N>
+  class RainFixedLru
+  {
+    static_assert(N > 0, "RainFixedLru 的容量必须大于 0");
+
+  public:
+    static constexpr size_t capacity() { return N; }
+
+    // 添加缓存
+    void put(const Key &key, const Value &value)
+    {
+      size_t index = find(key);
+      if (index == N)
+        index = size_ < N ? size_++ : leastRecent();
+      keys_[index] = key;
+      values_[index] = value;
+      stamps_[index] = ++clock_;
+    }
+
+    // 查询缓存，传出参数
+    bool get(const Key &key, Value &value)
+    {
+      size_t index = find(key);
+      if (index == N)
+        return false;
+      stamps_[index] = ++clock_;
+      value = values_[index];
+      return true;
+    }
+
+    // 查询缓存，返回值
+    Value get(const Key &key)
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素，最后一个条目补到空位上
+    bool remove(const Key &key)
+    {
+      size_t index = find(key);
+      if (index == N)
+        return false;
+      --size_;
+      keys_[index] = keys_[size_];
+      values_[index] = values_[size_];
+      stamps_[index] = stamps_[size_];
+      return true;
+    }
+
+    // 是否在缓存中，不更新访问顺序
+    bool contains(const Key &key) const { return find(key) != N; }
+
+    size_t size() const { return size_; }
+
+    void clear() { size_ = 0; }
+
+  private:
+    // 线性扫描，未找到返回 N
+    size_t find(const Key &key) const
+    {
+      for (size_t i = 0; i < size_; ++i)
+      {
+        if (keys_[i] == key)
+          return i;
+      }
+      return N;
+    }
+
+    size_t leastRecent() const
+    {
+      size_t oldest = 0;
+      for (size_t i = 1; i < N; ++i)
+      {
+        if (stamps_[i] < stamps_[oldest])
+          oldest = i;
+      }
+      return oldest;
+    }
+
+  private:
+    std::array<Key, N> keys_{};
+    std::array<Value, N> values_{};
+    std::array<uint64_t, N> stamps_{}; // 最后访问时间戳
+    size_t size_ = 0;
+    uint64_t clock_ = 0; // 逻辑时钟，每次访问加一
+  };
+} // namespace RainCache
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "RainCache.h"
+#include "RainLru.h"
+#include "RainStats.h"
+
+namespace RainCache
+{
+  // key 与 value 都是不超过 16 字节的可平凡拷贝类型时，可以直接放进索引槽
+  template <typename Key, typename Value>
+  inline constexpr bool kFlatLruEligible =
+      std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value> &&
+      std::is_default_constructible_v<Key> && std::is_default_constructible_v<Value> &&
+      sizeof(Key) <= 16 && sizeof(Value) <= 16;
+
+  // 扁平 LRU：线性探测的开放寻址表，每个槽直接保存 key、value 与 LRU 双向链表的前后槽号
+  // 没有逐条目的堆分配，也没有 shared_ptr 控制块；表长约为容量的 1.25 倍，
+  // 删除时把后续探测链向前平移（backward shift），不留墓碑，平移时同步修正链表中指向它的槽号
+  // 容量为 0 时不分配槽位，所有操作直接返回，与 RainLru(0) 的行为一致
+  template <typename Key, typename Value>
+  class RainFlatLru : public RainCache<Key, Value>
+  {
+    static_assert(kFlatLruEligible<Key, Value>, "RainFlatLru 只支持不超过 16 字节的可平凡拷贝 key/value");
+
+  public:
+    explicit RainFlatLru(int capacity)
+        : capacity_(capacity > 0 ? static_cast<size_t>(capacity) : 0),
+          slots_(capacity_ > 0 ? capacity_ + capacity_ / 4 + 1 : 0)
+    {
+    }
+
+    // 添加缓存
+    void put(Key key, Value value) override
+    {
+      if (capacity_ == 0)
+        return;
+
+      stats_.recordPut();
+      std::lock_guard<std::mutex> lock(mutex_);
+      uint32_t index = find(key);
+      if (index != kNil)
+      {
+        slots_[index].value = value;
+        moveToMostRecent(index);
+        return;
+      }
+
+      if (size_ >= capacity_)
+        evictLeastRecent();
+
+      // 淘汰会平移槽位，插入位置在淘汰之后重新探测
+      index = home(key);
+      while (slots_[index].prev != kEmpty)
+      {
+        index = nextSlot(index);
+      }
+      slots_[index].key = key;
+      slots_[index].value = value;
+      linkMostRecent(index);
+      ++size_;
+    }
+
+    // 查询缓存，传出参数
+    bool get(Key key, Value &value) override
+    {
+      if (capacity_ == 0)
+      {
+        stats_.recordMiss();
+        return false;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      uint32_t index = find(key);
+      if (index == kNil)
+      {
+        stats_.recordMiss();
+        return false;
+      }
+      moveToMostRecent(index);
+      value = slots_[index].value;
+      stats_.recordHit();
+      return true;
+    }
+
+    // 查询缓存，返回值
+    Value get(Key key) override
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素
+    void remove(Key key)
+    {
+      if (capacity_ == 0)
+        return;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      uint32_t index = find(key);
+      if (index != kNil)
+        erase(index);
+    }
+
+    // 是否在缓存中，不更新访问顺序，也不计入命中统计
+    bool contains(Key key)
+    {
+      if (capacity_ == 0)
+        return false;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      return find(key) != kNil;
+    }
+
+    size_t size()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return size_;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    // 槽数组占用的字节数，即全部条目的内存开销
+    size_t memoryBytes() const { return slots_.size() * sizeof(Slot); }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    // 设置淘汰回调，需在并发访问开始前设置
+    void setEvictionCallback(EvictionCallback<Key, Value> callback) { onEvict_ = std::move(callback); }
+
+  private:
+    static constexpr uint32_t kNil = UINT32_MAX;       // 链表端点
+    static constexpr uint32_t kEmpty = UINT32_MAX - 1; // prev 为此值表示空槽
+
+    // prev 指向更近使用的槽，next 指向更久未用的槽
+    struct Slot
+    {
+      Key key{};
+      Value value{};
+      uint32_t prev = kEmpty;
+      uint32_t next = kNil;
+    };
+
+    // 对 std::hash 的结果再做一次混合，整数 key 的 std::hash 是恒等映射，直接用会全部落在表头
+    uint32_t home(const Key &key) const
+    {
+      uint64_t h = static_cast<uint64_t>(std::hash<Key>{}(key));
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<uint32_t>(((h >> 32) * slots_.size()) >> 32);
+    }
+
+    uint32_t nextSlot(uint32_t index) const { return index + 1 == slots_.size() ? 0 : index + 1; }
+
+    uint32_t find(const Key &key) const
+    {
+      for (uint32_t index = home(key); slots_[index].prev != kEmpty; index = nextSlot(index))
+      {
+        if (slots_[index].key == key)
+          return index;
+      }
+      return kNil;
+    }
+
+    void linkMostRecent(uint32_t index)
+    {
+      slots_[index].prev = kNil;
+      slots_[index].next = head_;
+      if (head_ != kNil)
+        slots_[head_].prev = index;
+      else
+        tail_ = index;
+      head_ = index;
+    }
+
+    void unlink(uint32_t index)
+    {
+      Slot &slot = slots_[index];
+      if (slot.prev != kNil)
+        slots_[slot.prev].next = slot.next;
+      else
+        head_ = slot.next;
+      if (slot.next != kNil)
+        slots_[slot.next].prev = slot.prev;
+      else
+        tail_ = slot.prev;
+    }
+
+    void moveToMostRecent(uint32_t index)
+    {
+      if (head_ == index)
+        return;
+      unlink(index);
+      linkMostRecent(index);
+    }
+
+    // 从链表摘除并清空槽位，后续探测链上不在自己原位的条目依次前移
+    void erase(uint32_t index)
+    {
+      unlink(index);
+      --size_;
+      uint32_t hole = index;
+      for (uint32_t current = nextSlot(hole); slots_[current].prev != kEmpty; current = nextSlot(current))
+      {
+        // 原位落在 (hole, current] 之间（循环意义下）的条目不能前移
+        uint32_t ideal = home(slots_[current].key);
+        bool stays = hole <= current ? (hole < ideal && ideal <= current) : (hole < ideal || ideal <= current);
+        if (stays)
+          continue;
+        moveSlot(current, hole);
+        hole = current;
+      }
+      slots_[hole] = Slot();
+    }
+
+    // 把槽 from 的内容搬到 to，并让链表上的邻居指向新位置
+    void moveSlot(uint32_t from, uint32_t to)
+    {
+      Slot &slot = slots_[to];
+      slot = slots_[from];
+      if (slot.prev != kNil)
+        slots_[slot.prev].next = to;
+      else
+        head_ = to;
+      if (slot.next != kNil)
+        slots_[slot.next].prev = to;
+      else
+        tail_ = to;
+    }
+
+    // 驱逐最近最少访问
+    void evictLeastRecent()
+    {
+      uint32_t index = tail_;
+      stats_.recordEviction();
+      if (onEvict_)
+        onEvict_(slots_[index].key, slots_[index].value);
+      erase(index);
+    }
+
+  private:
+    size_t capacity_;          // 缓存容量
+    std::vector<Slot> slots_;  // 开放寻址槽
+    size_t size_ = 0;          // 当前条目数
+    uint32_t head_ = kNil;     // 最近使用
+    uint32_t tail_ = kNil;     // 最久未用
+    std::mutex mutex_;         // 互斥锁
+    CacheStats stats_;         // 命中/淘汰统计
+    EvictionCallback<Key, Value> onEvict_; // 淘汰回调，为空时不调用
+  };
+
+  // 按 key/value 类型自动选择：满足条件时用扁平 LRU，否则用基于节点的 RainLru
+  template <typename Key, typename Value>
+  using RainLruFor = std::conditional_t<kFlatLruEligible<Key, Value>, RainFlatLru<Key, Value>, RainLru<Key, Value>>;
+} // namespace RainCache
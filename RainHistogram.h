@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace RainCache
+{
+  // 直方图快照，可以跨分片合并后再计算分位数
+  struct LatencySnapshot
+  {
+    std::vector<uint64_t> counts; // 每个桶的样本数
+    uint64_t count = 0;           // 样本总数
+    uint64_t sum = 0;             // 样本总和（纳秒）
+    uint64_t max = 0;             // 最大样本（纳秒）
+
+    // 合并另一个快照
+    LatencySnapshot &merge(const LatencySnapshot &other)
+    {
+      if (counts.size() < other.counts.size())
+        counts.resize(other.counts.size(), 0);
+      for (size_t i = 0; i < other.counts.size(); ++i)
+      {
+        counts[i] += other.counts[i];
+      }
+      count += other.count;
+      sum += other.sum;
+      max = std::max(max, other.max);
+      return *this;
+    }
+
+    // 平均值（纳秒）
+    double mean() const
+    {
+      return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+    }
+
+    // 分位数（纳秒），q 取值 [0, 1]，返回所在桶的上界
+    uint64_t percentile(double q) const;
+  };
+
+  // 对数分桶延迟直方图（HDR 风格）
+  // 每个 2 的幂区间再线性细分为 8 个子桶，相对误差不超过 12.5%
+  // record 只做一次 relaxed 原子加，可以在多个线程中同时调用
+  class LatencyHistogram
+  {
+  public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr uint64_t kSubBucketNum = 1ULL << kSubBucketBits;
+    static constexpr size_t kBucketNum = (64 - kSubBucketBits + 1) * kSubBucketNum;
+
+    // 记录一个样本（纳秒）
+    void record(uint64_t nanos)
+    {
+      counts_[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+      count_.fetch_add(1, std::memory_order_relaxed);
+      sum_.fetch_add(nanos, std::memory_order_relaxed);
+
+      uint64_t curMax = max_.load(std::memory_order_relaxed);
+      while (nanos > curMax && !max_.compare_exchange_weak(curMax, nanos, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    // 读取快照
+    LatencySnapshot snapshot() const
+    {
+      LatencySnapshot result;
+      result.counts.resize(kBucketNum);
+      for (size_t i = 0; i < kBucketNum; ++i)
+      {
+        result.counts[i] = counts_[i].load(std::memory_order_relaxed);
+      }
+      result.count = count_.load(std::memory_order_relaxed);
+      result.sum = sum_.load(std::memory_order_relaxed);
+      result.max = max_.load(std::memory_order_relaxed);
+      return result;
+    }
+
+    // 样本所在桶：小于 8 的值各占一个桶，其余按最高位分组后再取次高 3 位
+    static size_t bucketIndex(uint64_t value)
+    {
+      if (value < kSubBucketNum)
+        return static_cast<size_t>(value);
+
+      int exponent = 63 - __builtin_clzll(value);
+      uint64_t sub = (value >> (exponent - kSubBucketBits)) & (kSubBucketNum - 1);
+      return static_cast<size_t>((exponent - kSubBucketBits + 1) * kSubBucketNum + sub);
+    }
+
+    // 桶的上界
+    static uint64_t bucketUpperBound(size_t index)
+    {
+      if (index < kSubBucketNum)
+        return index;
+
+      int exponent = static_cast<int>(index / kSubBucketNum) + kSubBucketBits - 1;
+      uint64_t sub = index % kSubBucketNum;
+      uint64_t width = 1ULL << (exponent - kSubBucketBits);
+      return ((kSubBucketNum + sub) << (exponent - kSubBucketBits)) + width - 1;
+    }
+
+  private:
+    std::atomic<uint64_t> counts_[kBucketNum] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+  };
+
+  inline uint64_t LatencySnapshot::percentile(double q) const
+  {
+    if (count == 0)
+      return 0;
+
+    uint64_t rank = static_cast<uint64_t>(q * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+      seen += counts[i];
+      if (seen >= rank)
+        return std::min(LatencyHistogram::bucketUpperBound(i), max);
+    }
+    return max;
+  }
+
+  // 单个分片的延迟快照
+  struct ShardLatencySnapshot
+  {
+    LatencySnapshot get;      // get 耗时（含等锁）
+    LatencySnapshot put;      // put 耗时（含等锁）
+    LatencySnapshot eviction; // 单次淘汰耗时
+    LatencySnapshot aging;    // LFU 频次老化耗时
+    LatencySnapshot lockWait; // 等待分片互斥锁的时间
+    LatencySnapshot lockHold; // 持有分片互斥锁的时间
+
+    ShardLatencySnapshot &merge(const ShardLatencySnapshot &other)
+    {
+      get.merge(other.get);
+      put.merge(other.put);
+      eviction.merge(other.eviction);
+      aging.merge(other.aging);
+      lockWait.merge(other.lockWait);
+      lockHold.merge(other.lockHold);
+      return *this;
+    }
+  };
+
+  // 单个分片的延迟直方图集合，由分片包装类按需创建并交给分片缓存记录
+  struct ShardLatency
+  {
+    LatencyHistogram get;
+    LatencyHistogram put;
+    LatencyHistogram eviction;
+    LatencyHistogram aging;
+    LatencyHistogram lockWait;
+    LatencyHistogram lockHold;
+
+    ShardLatencySnapshot snapshot() const
+    {
+      ShardLatencySnapshot result;
+      result.get = get.snapshot();
+      result.put = put.snapshot();
+      result.eviction = eviction.snapshot();
+      result.aging = aging.snapshot();
+      result.lockWait = lockWait.snapshot();
+      result.lockHold = lockHold.snapshot();
+      return result;
+    }
+  };
+
+  // 作用域计时：histogram 为空时不读时钟
+  class LatencyTimer
+  {
+  public:
+    explicit LatencyTimer(LatencyHistogram *histogram)
+        : histogram_(histogram),
+          start_(histogram ? now() : 0)
+    {
+    }
+
+    ~LatencyTimer()
+    {
+      if (histogram_)
+        histogram_->record(now() - start_);
+    }
+
+    static uint64_t now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+    }
+
+  private:
+    LatencyHistogram *histogram_;
+    uint64_t start_;
+  };
+
+  // 带计时的 lock_guard：记录等锁时间与持锁时间，latency 为空时等同 std::lock_guard
+  template <typename Mutex>
+  class TimedLockGuard
+  {
+  public:
+    TimedLockGuard(Mutex &mutex, ShardLatency *latency)
+        : mutex_(mutex),
+          latency_(latency),
+          acquired_(0)
+    {
+      if (!latency_)
+      {
+        mutex_.lock();
+        return;
+      }
+
+      uint64_t begin = LatencyTimer::now();
+      mutex_.lock();
+      acquired_ = LatencyTimer::now();
+      latency_->lockWait.record(acquired_ - begin);
+    }
+
+    ~TimedLockGuard()
+    {
+      if (latency_)
+        latency_->lockHold.record(LatencyTimer::now() - acquired_);
+      mutex_.unlock();
+    }
+
+    TimedLockGuard(const TimedLockGuard &) = delete;
+    TimedLockGuard &operator=(const TimedLockGuard &) = delete;
+
+  private:
+    Mutex &mutex_;
+    ShardLatency *latency_;
+    uint64_t acquired_;
+  };
+} // namespace RainCache
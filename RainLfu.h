@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <mutex>
@@ -8,6 +9,9 @@
 #include <vector>
 
 #include "RainCache.h"
+#include "RainHistogram.h"
+#include "RainSnapshot.h"
+#include "RainStats.h"
 
 namespace RainCache
 {
@@ -61,6 +65,21 @@ namespace RainCache
       tail_->pre = head_;
     }
 
+    // 逐个断开节点，避免 shared_ptr 链在析构时递归过深导致栈溢出
+    ~FreqList()
+    {
+      NodePtr node = head_->next;
+      while (node)
+      {
+        NodePtr next = node->next;
+        node->next = nullptr;
+        node = next;
+      }
+    }
+
+    FreqList(const FreqList &) = delete;
+    FreqList &operator=(const FreqList &) = delete;
+
     // 列表是否为空
     bool isEmpty() const
     {
@@ -117,11 +136,12 @@ namespace RainCache
           minFreq_(INT8_MAX),
           maxAverageNum_(maxAverageNum),
           curAverageNum_(0),
-          curTotalNum_(0)
+          curTotalNum_(0),
+          latency_(nullptr)
     {
     }
 
-    ~RainLfu() override = default;
+    ~RainLfu() override { clearInternal(); }
 
     // 存入缓存
     void put(Key key, Value value) override
@@ -129,7 +149,9 @@ namespace RainCache
       if (capacity_ == 0)
         return;
 
-      std::lock_guard<std::mutex> lock(mutex_);
+      LatencyTimer timer(latency_ ? &latency_->put : nullptr);
+      stats_.recordPut();
+      TimedLockGuard<std::mutex> lock(mutex_, latency_);
       auto it = nodeMap_.find(key);
       if (it != nodeMap_.end())
       {
@@ -146,14 +168,17 @@ namespace RainCache
     // get 接口，传出参数
     bool get(Key key, Value &value) override
     {
-      std::lock_guard<std::mutex> lock(mutex_);
+      LatencyTimer timer(latency_ ? &latency_->get : nullptr);
+      TimedLockGuard<std::mutex> lock(mutex_, latency_);
       auto it = nodeMap_.find(key);
       if (it != nodeMap_.end())
       {
         getInternal(it->second, value);
+        stats_.recordHit();
         return true;
       }
 
+      stats_.recordMiss();
       return false;
     }
 
@@ -165,14 +190,148 @@ namespace RainCache
       return value;
     }
 
+    // 删除指定元素，删掉的若是最小频次链表的最后一个结点则重新计算最小频次
+    void remove(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = nodeMap_.find(key);
+      if (it == nodeMap_.end())
+        return;
+
+      NodePtr node = it->second;
+      removeFromFreqList(node);
+      nodeMap_.erase(it);
+      decreaseFreqNum(node->freq);
+      if (node->freq == minFreq_ && freqToFreqList_[minFreq_]->isEmpty())
+        updateMinFreq();
+    }
+
     // 清空缓存,回收资源
     void purge()
     {
-      nodeMap_.clear();
-      freqToFreqList_.clear();
+      clearInternal();
+    }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    // 设置延迟记录器，传入空指针关闭记录，需在并发访问开始前设置
+    void setLatencyRecorder(ShardLatency *latency) { latency_ = latency; }
+
+    // 保存快照到文件
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      SnapshotWriter out;
+      if (!out.open(path))
+        return false;
+      out.writeHeader(SnapshotPolicy::Lfu);
+      writeSnapshot<KeySerializer, ValueSerializer>(out);
+      return out.close();
+    }
+
+    // 从文件加载快照，替换当前全部内容；打开失败、策略不符或条目损坏时返回 false，当前内容不变
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path)
+    {
+      SnapshotReader in;
+      if (!in.open(path) || !in.readHeader(SnapshotPolicy::Lfu))
+        return false;
+      return readSnapshot<KeySerializer, ValueSerializer>(in);
+    }
+
+    // 写出条目（不含文件头）：按频次从低到高、同频次按链表顺序，每条为 (freq, key, value)
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<int> freqs;
+      for (const auto &pair : freqToFreqList_)
+      {
+        freqs.push_back(pair.first);
+      }
+      std::sort(freqs.begin(), freqs.end());
+
+      out.writePod<uint64_t>(nodeMap_.size());
+      for (int freq : freqs)
+      {
+        FreqList<Key, Value> *list = freqToFreqList_[freq];
+        for (NodePtr node = list->head_->next; node != list->tail_; node = node->next)
+        {
+          out.writePod<int32_t>(node->freq);
+          KeySerializer::write(out, node->key);
+          ValueSerializer::write(out, node->value);
+        }
+      }
+    }
+
+    // 读入条目（不含文件头），保留原有访问频次；条目数超过容量时丢弃频次最低的部分
+    // 先把条目读到临时缓冲，全部读完后才加锁替换当前内容，条目损坏时返回 false，当前内容不变
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool readSnapshot(SnapshotReader &in)
+    {
+      struct Loaded
+      {
+        int32_t freq;
+        Key key;
+        Value value;
+      };
+
+      uint64_t count = 0;
+      if (!in.readPod(count))
+        return false;
+      // 条目按频次升序排列，超出容量的部分就是开头频次最低的那些
+      uint64_t skip = count > static_cast<uint64_t>(std::max(capacity_, 0)) ? count - std::max(capacity_, 0) : 0;
+      std::vector<Loaded> entries;
+      entries.reserve(count - skip);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        int32_t freq = 0;
+        Key key{};
+        Value value{};
+        if (!in.readPod(freq) || !KeySerializer::read(in, key) || !ValueSerializer::read(in, value))
+          return false;
+        if (i >= skip)
+          entries.push_back({freq, std::move(key), std::move(value)});
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      clearInternal();
+      nodeMap_.reserve(entries.size());
+      int minFreq = 0;
+      for (const Loaded &entry : entries)
+      {
+        if (nodeMap_.count(entry.key))
+          continue;
+
+        NodePtr node = std::make_shared<Node>(entry.key, entry.value);
+        node->freq = std::max(entry.freq, 1);
+        nodeMap_[entry.key] = node;
+        addToFreqList(node);
+        curTotalNum_ += node->freq;
+        minFreq = minFreq == 0 ? node->freq : std::min(minFreq, node->freq);
+      }
+      curAverageNum_ = nodeMap_.empty() ? 0 : curTotalNum_ / nodeMap_.size();
+      // 最小频次取实际载入的频次，频次可能全部大于 INT8_MAX
+      minFreq_ = minFreq == 0 ? 1 : minFreq;
+      return true;
     }
 
   private:
+    // 释放所有频次链表与节点，并重置计数
+    void clearInternal()
+    {
+      for (auto &pair : freqToFreqList_)
+      {
+        delete pair.second;
+      }
+      freqToFreqList_.clear();
+      nodeMap_.clear();
+      minFreq_ = INT8_MAX;
+      curAverageNum_ = 0;
+      curTotalNum_ = 0;
+    }
+
     // 添加缓存
     void putInternal(Key key, Value value)
     {
@@ -213,10 +372,12 @@ namespace RainCache
     // 移除缓存中的过期数据
     void kickOut()
     {
+      LatencyTimer timer(latency_ ? &latency_->eviction : nullptr);
       NodePtr node = freqToFreqList_[minFreq_]->getFirstNode();
       removeFromFreqList(node);
       nodeMap_.erase(node->key);
       decreaseFreqNum(node->freq);
+      stats_.recordEviction();
     }
 
     // 从频率列表中移除节点
@@ -279,7 +440,11 @@ namespace RainCache
       if (nodeMap_.empty())
         return;
 
+      stats_.recordAging();
+      LatencyTimer timer(latency_ ? &latency_->aging : nullptr);
       // 当前平均访问频次已经超过了最大平均访问频次，所有结点的访问频次- (maxAverageNum_ / 2)
+      // 同时按老化后的频次重新累计总访问频次，否则平均值不会下降，之后每次访问都会再次触发老化
+      curTotalNum_ = 0;
       for (auto it = nodeMap_.begin(); it != nodeMap_.end(); ++it)
       {
         // 检查结点是否为空
@@ -298,22 +463,28 @@ namespace RainCache
 
         // 添加到新的频率列表
         addToFreqList(node);
+        curTotalNum_ += node->freq;
       }
+      curAverageNum_ = curTotalNum_ / nodeMap_.size();
 
       // 更新最小频率
       updateMinFreq();
     }
 
     // 更新最小频率
+    // 没有非空链表时置为 1；频次可能大于 INT8_MAX，不能用它作未找到的标记
     void updateMinFreq()
     {
-      minFreq_ = INT8_MAX;
+      bool found = false;
       for (const auto &pair : freqToFreqList_)
       {
         if (pair.second && !pair.second->isEmpty())
-          minFreq_ = std::min(minFreq_, pair.first);
+        {
+          minFreq_ = found ? std::min(minFreq_, pair.first) : pair.first;
+          found = true;
+        }
       }
-      if (minFreq_ == INT8_MAX)
+      if (!found)
         minFreq_ = 1;
     }
 
@@ -326,6 +497,8 @@ namespace RainCache
     std::mutex mutex_;                                               // 互斥锁
     NodeMap nodeMap_;                                                // key 到 缓存节点的映射
     std::unordered_map<int, FreqList<Key, Value> *> freqToFreqList_; // 访问频次到该频次链表的映射
+    CacheStats stats_;                                               // 命中/淘汰/老化统计
+    ShardLatency *latency_;                                          // 延迟直方图，为空时不记录
   };
 
   // Lfu 哈希分片
@@ -370,6 +543,12 @@ namespace RainCache
       return value;
     }
 
+    // 删除指定元素
+    void remove(Key key)
+    {
+      lfuSliceCaches_[Hash(key) % sliceNum_]->remove(key);
+    }
+
     // 清除缓存
     void purge()
     {
@@ -379,6 +558,66 @@ namespace RainCache
       }
     }
 
+    // 所有分片的统计汇总
+    CacheStatsSnapshot stats() const
+    {
+      CacheStatsSnapshot total;
+      for (const auto &lfuSliceCache : lfuSliceCaches_)
+      {
+        total += lfuSliceCache->stats();
+      }
+      return total;
+    }
+
+    // 保存快照，每个分片一个带 CRC32C 的段
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      return saveShardedSnapshot(path, SnapshotPolicy::LfuHash, sliceNum_, [this](int i, SnapshotWriter &out)
+                                 { lfuSliceCaches_[i]->template writeSnapshot<KeySerializer, ValueSerializer>(out); });
+    }
+
+    // 在 threadNum 个线程上并行校验并重建各分片，threadNum 为 0 时使用硬件并发数
+    // 分片数必须与保存时一致，否则返回 false
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path, int threadNum = 0)
+    {
+      return loadShardedSnapshot(path, SnapshotPolicy::LfuHash, sliceNum_, threadNum, [this](int i, SnapshotReader &in)
+                                 { return lfuSliceCaches_[i]->template readSnapshot<KeySerializer, ValueSerializer>(in); });
+    }
+
+    // 为每个分片开启延迟直方图，需在并发访问开始前调用
+    void enableLatencyTracking()
+    {
+      if (!sliceLatency_.empty())
+        return;
+
+      for (int i = 0; i < sliceNum_; ++i)
+      {
+        sliceLatency_.emplace_back(new ShardLatency());
+        lfuSliceCaches_[i]->setLatencyRecorder(sliceLatency_[i].get());
+      }
+    }
+
+    // 指定分片的延迟快照
+    ShardLatencySnapshot latencySnapshot(int sliceIndex) const
+    {
+      if (sliceIndex < 0 || sliceIndex >= static_cast<int>(sliceLatency_.size()))
+        return ShardLatencySnapshot();
+      return sliceLatency_[sliceIndex]->snapshot();
+    }
+
+    // 所有分片合并后的延迟快照
+    ShardLatencySnapshot latencySnapshot() const
+    {
+      ShardLatencySnapshot total;
+      for (const auto &latency : sliceLatency_)
+      {
+        total.merge(latency->snapshot());
+      }
+      return total;
+    }
+
   private:
     // 将 key 计算成对应哈希值
     size_t Hash(Key key)
@@ -391,5 +630,6 @@ namespace RainCache
     size_t capacity_;                                                  // 缓存总容量
     int sliceNum_;                                                     // 缓存分片数量
     std::vector<std::unique_ptr<RainLfu<Key, Value>>> lfuSliceCaches_; // 缓存lfu分片容器
+    std::vector<std::unique_ptr<ShardLatency>> sliceLatency_;          // 分片延迟直方图，开启后才创建
   };
 }
\ No newline at end of file
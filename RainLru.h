@@ -1,13 +1,31 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
 #include <cstring>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <time.h>
+#endif
 
 #include "RainCache.h"
+#include "RainHistogram.h"
+#include "RainMrc.h"
+#include "RainSnapshot.h"
+#include "RainStats.h"
+#include "RainTopK.h"
 
 namespace RainCache
 {
@@ -22,6 +40,7 @@ namespace RainCache
     Key key_;
     Value value_;
     size_t accessCount_;                        // 访问次数
+    uint64_t stamp_;                            // 最近一次放到链表最新端时的代数或毫秒时间，用于限制提升频率
     std::shared_ptr<LruNode<Key, Value>> next_; // 智能管理指针空间
     std::weak_ptr<LruNode<Key, Value>> prev_;   // 防止循环引用
 
@@ -29,7 +48,8 @@ namespace RainCache
     explicit LruNode(Key key, Value value)
         : key_(key),
           value_(value),
-          accessCount_(1)
+          accessCount_(1),
+          stamp_(0)
     {
     }
 
@@ -52,12 +72,13 @@ namespace RainCache
     using NodeMap = std::unordered_map<Key, NodePtr>;
 
     explicit RainLru(int capacity)
-        : capacity_(capacity)
+        : capacity_(capacity),
+          latency_(nullptr)
     {
       initializeList();
     }
 
-    ~RainLru() override = default;
+    ~RainLru() override { clearList(); }
 
     // 添加缓存
     void put(Key key, Value value) override
@@ -65,7 +86,10 @@ namespace RainCache
       if (capacity_ <= 0)
         return;
 
-      std::lock_guard<std::mutex> lock(mutex_);
+      LatencyTimer timer(latency_ ? &latency_->put : nullptr);
+      stats_.recordPut();
+      TimedLockGuard<std::mutex> lock(mutex_, latency_);
+      std::unique_lock<std::shared_mutex> indexLock = lockIndex();
       auto it = nodeMap_.find(key);
       if (it != nodeMap_.end())
       {
@@ -80,14 +104,20 @@ namespace RainCache
     // 查询缓存，传出参数
     bool get(Key key, Value &value) override
     {
-      std::lock_guard<std::mutex> lock(mutex_);
+      if (lossyPromotion_)
+        return getLossy(key, value);
+
+      LatencyTimer timer(latency_ ? &latency_->get : nullptr);
+      TimedLockGuard<std::mutex> lock(mutex_, latency_);
       auto it = nodeMap_.find(key);
       if (it != nodeMap_.end())
       {
-        moveToMostRecent(it->second);
+        promote(it->second);
         value = it->second->getValue();
+        stats_.recordHit();
         return true;
       }
+      stats_.recordMiss();
       return false;
     }
 
@@ -103,6 +133,7 @@ namespace RainCache
     void remove(Key key)
     {
       std::lock_guard<std::mutex> lock(mutex_);
+      std::unique_lock<std::shared_mutex> indexLock = lockIndex();
       auto it = nodeMap_.find(key);
       if (it != nodeMap_.end())
       {
@@ -111,7 +142,215 @@ namespace RainCache
       }
     }
 
+    // 是否在缓存中，不更新访问顺序，也不计入命中统计
+    bool contains(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return nodeMap_.find(key) != nodeMap_.end();
+    }
+
+    // 只更新访问顺序（同样受提升频率限制），不拷贝 value，也不计入命中统计
+    // 用于把分片之外（如近端缓存）发生的命中转发给分片
+    bool touch(Key key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = nodeMap_.find(key);
+      if (it == nodeMap_.end())
+        return false;
+      promote(it->second);
+      return true;
+    }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    // 设置延迟记录器，传入空指针关闭记录，需在并发访问开始前设置
+    void setLatencyRecorder(ShardLatency *latency) { latency_ = latency; }
+
+    // 设置淘汰回调，需在并发访问开始前设置
+    void setEvictionCallback(EvictionCallback<Key, Value> callback) { onEvict_ = std::move(callback); }
+
+    // 有损提升模式，需在并发访问开始前设置
+    // 开启后 get 只在共享锁下查索引并拷贝 value，读者之间互不阻塞；移到最近位置改用 try_lock，
+    // 锁被占用时直接跳过这次提升，以略微不精确的 LRU 顺序换取读者不排队。
+    // 写入方除链表锁外还要独占索引锁，因此只在读远多于写时有收益
+    void setLossyPromotion(bool enabled) { lossyPromotion_ = enabled; }
+
+    // 限制提升频率，需在并发访问开始前设置；两种方式只生效最后设置的一种，参数为 0 时关闭
+    // 按位置：get 命中时，若节点放到最新端之后链表只新增了不到 topFraction * 容量 次插入/提升，
+    // 它一定还在最新的这部分里，跳过这次移动
+    void setPromotionWindow(double topFraction)
+    {
+      throttle_ = topFraction > 0 ? Throttle::Window : Throttle::None;
+      promotionWindow_ = static_cast<uint64_t>(std::max(topFraction, 0.0) * capacity_);
+    }
+
+    // 按时间：get 命中时，若节点在 interval 之内已被放到最新端，跳过这次移动（与 memcached 相同的做法）
+    void setPromotionInterval(std::chrono::milliseconds interval)
+    {
+      throttle_ = interval.count() > 0 ? Throttle::Interval : Throttle::None;
+      promotionInterval_ = static_cast<uint64_t>(std::max<int64_t>(interval.count(), 0));
+    }
+
+    // 因限制提升频率而跳过的移动次数
+    uint64_t skippedPromotions()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return skippedPromotions_;
+    }
+
+    // 保存快照到文件
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      SnapshotWriter out;
+      if (!out.open(path))
+        return false;
+      out.writeHeader(SnapshotPolicy::Lru);
+      writeSnapshot<KeySerializer, ValueSerializer>(out);
+      return out.close();
+    }
+
+    // 从文件加载快照，替换当前全部内容；打开失败、策略不符或条目损坏时返回 false，当前内容不变
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path)
+    {
+      SnapshotReader in;
+      if (!in.open(path) || !in.readHeader(SnapshotPolicy::Lru))
+        return false;
+      return readSnapshot<KeySerializer, ValueSerializer>(in);
+    }
+
+    // 写出条目（不含文件头），按从旧到新的访问顺序，加载时依次插入即可恢复 LRU 顺序
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    void writeSnapshot(SnapshotWriter &out)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      out.writePod<uint64_t>(nodeMap_.size());
+      for (NodePtr node = dummyHead_->next_; node != dummyTail_; node = node->next_)
+      {
+        KeySerializer::write(out, node->key_);
+        ValueSerializer::write(out, node->value_);
+      }
+    }
+
+    // 读入条目（不含文件头），条目数超过容量时跳过开头最旧的部分；重复的 key 以后出现的为准
+    // 先把条目读到临时缓冲，全部读完后才加锁替换当前内容，条目损坏时返回 false，当前内容不变
+    // 条目直接插入，不经过淘汰，不触发淘汰回调也不计入统计
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool readSnapshot(SnapshotReader &in)
+    {
+      uint64_t count = 0;
+      if (!in.readPod(count))
+        return false;
+      uint64_t capacity = static_cast<uint64_t>(std::max(capacity_, 0));
+      uint64_t skip = count > capacity ? count - capacity : 0;
+      std::vector<std::pair<Key, Value>> entries;
+      entries.reserve(count - skip);
+      for (uint64_t i = 0; i < count; ++i)
+      {
+        Key key{};
+        Value value{};
+        if (!KeySerializer::read(in, key) || !ValueSerializer::read(in, value))
+          return false;
+        if (i >= skip)
+          entries.emplace_back(std::move(key), std::move(value));
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::unique_lock<std::shared_mutex> indexLock = lockIndex();
+      clearList();
+      nodeMap_.reserve(entries.size());
+      for (auto &entry : entries)
+      {
+        auto it = nodeMap_.find(entry.first);
+        if (it != nodeMap_.end())
+        {
+          updateExistingNode(it->second, entry.second);
+          continue;
+        }
+        NodePtr node = std::make_shared<LruNodeType>(entry.first, entry.second);
+        insertNode(node);
+        nodeMap_[entry.first] = node;
+      }
+      return true;
+    }
+
   private:
+    // 有损提升模式下修改索引或 value 前独占 indexMutex_，普通模式下返回空锁
+    std::unique_lock<std::shared_mutex> lockIndex()
+    {
+      return lossyPromotion_ ? std::unique_lock<std::shared_mutex>(indexMutex_) : std::unique_lock<std::shared_mutex>();
+    }
+
+    // get 命中后的提升，按设置跳过最近刚提升过的节点
+    void promote(NodePtr node)
+    {
+      bool recent = false;
+      if (throttle_ == Throttle::Window)
+        recent = generation_ - node->stamp_ < promotionWindow_;
+      else if (throttle_ == Throttle::Interval)
+        recent = coarseMillis() - node->stamp_ < promotionInterval_;
+      if (recent)
+      {
+        ++skippedPromotions_;
+        return;
+      }
+      moveToMostRecent(node);
+    }
+
+    // 粗粒度单调时钟（毫秒），Linux 上读 CLOCK_MONOTONIC_COARSE，只是一次 vDSO 内存读取
+    static uint64_t coarseMillis()
+    {
+#if defined(__linux__)
+      timespec ts;
+      clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+      return static_cast<uint64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+#else
+      return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    // 有损提升模式的查询：索引只加共享锁，提升只尝试加锁
+    bool getLossy(const Key &key, Value &value)
+    {
+      LatencyTimer timer(latency_ ? &latency_->get : nullptr);
+      NodePtr node;
+      {
+        std::shared_lock<std::shared_mutex> indexLock(indexMutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end())
+        {
+          stats_.recordMiss();
+          return false;
+        }
+        node = it->second;
+        value = node->value_;
+      }
+      stats_.recordHit();
+
+      // 节点可能在两次加锁之间被淘汰或删除（next_ 已断开），只提升仍在链表中的节点
+      std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+      if (lock.owns_lock() && node->next_)
+        promote(node);
+      return true;
+    }
+
+    // 逐个断开节点后清空，避免 shared_ptr 链在析构时递归过深导致栈溢出
+    void clearList()
+    {
+      NodePtr node = dummyHead_->next_;
+      while (node && node != dummyTail_)
+      {
+        NodePtr next = node->next_;
+        node->next_ = nullptr;
+        node = next;
+      }
+      dummyHead_->next_ = dummyTail_;
+      dummyTail_->prev_ = dummyHead_;
+      nodeMap_.clear();
+    }
+
     // 初始化链表
     void initializeList()
     {
@@ -164,6 +403,11 @@ namespace RainCache
     // 从尾部插入结点
     void insertNode(NodePtr node)
     {
+      ++generation_;
+      if (throttle_ == Throttle::Window)
+        node->stamp_ = generation_;
+      else if (throttle_ == Throttle::Interval)
+        node->stamp_ = coarseMillis();
       node->next_ = dummyTail_;
       node->prev_ = dummyTail_->prev_;
       dummyTail_->prev_.lock()->next_ = node; // 使用lock()获取shared_ptr
@@ -173,17 +417,38 @@ namespace RainCache
     // 驱逐最近最少访问
     void evictLeastRecent()
     {
+      LatencyTimer timer(latency_ ? &latency_->eviction : nullptr);
       NodePtr leastRecent = dummyHead_->next_;
       removeNode(leastRecent);
       nodeMap_.erase(leastRecent->getKey());
+      stats_.recordEviction();
+      if (onEvict_)
+        onEvict_(leastRecent->key_, leastRecent->value_);
     }
 
   private:
-    int capacity_;      // 缓存容量
-    NodeMap nodeMap_;   // key -> Node
-    std::mutex mutex_;  // 互斥锁
-    NodePtr dummyHead_; // 虚拟头结点
-    NodePtr dummyTail_; // 虚拟尾结点
+    int capacity_;          // 缓存容量
+    NodeMap nodeMap_;       // key -> Node
+    std::mutex mutex_;      // 互斥锁
+    std::shared_mutex indexMutex_; // 有损提升模式下保护索引与 value，普通模式不使用
+    bool lossyPromotion_ = false;  // 是否开启有损提升
+
+    enum class Throttle
+    {
+      None,
+      Window,
+      Interval
+    };
+    Throttle throttle_ = Throttle::None; // 提升频率限制方式
+    uint64_t promotionWindow_ = 0;       // 按位置限制时的窗口（插入/提升次数）
+    uint64_t promotionInterval_ = 0;     // 按时间限制时的间隔（毫秒）
+    uint64_t generation_ = 0;            // 链表最新端的插入/提升总次数
+    uint64_t skippedPromotions_ = 0;     // 跳过的提升次数
+    NodePtr dummyHead_;     // 虚拟头结点
+    NodePtr dummyTail_;     // 虚拟尾结点
+    CacheStats stats_;      // 命中/淘汰统计
+    ShardLatency *latency_; // 延迟直方图，为空时不记录
+    EvictionCallback<Key, Value> onEvict_; // 淘汰回调，为空时不调用
   };
 
   // LRU-k 优化，继承 LRU 类
@@ -246,9 +511,8 @@ namespace RainCache
     // 存入缓存
     void put(Key key, Value value)
     {
-      // 检查是否已在主缓存
-      Value existingValue{};
-      bool inMainCache = RainLru<Key, Value>::get(key, existingValue);
+      // 检查是否已在主缓存，这里只是判断存在与否，不计入命中统计
+      bool inMainCache = RainLru<Key, Value>::contains(key);
 
       if (inMainCache)
       {
@@ -275,6 +539,14 @@ namespace RainCache
       }
     }
 
+    // 删除指定元素，连同尚未进入主缓存的访问历史与暂存值
+    void remove(Key key)
+    {
+      RainLru<Key, Value>::remove(key);
+      historyList_->remove(key);
+      historyValueMap_.erase(key);
+    }
+
   private:
     int k_;                                             // 进入缓存队列的评判标准
     std::unique_ptr<RainLru<Key, size_t>> historyList_; // 访问数据历史记录(value为访问次数)
@@ -298,20 +570,60 @@ namespace RainCache
       }
     }
 
+    ~RainLruHash() { stopHotRefresh(); }
+
     // 每个分片都是一个 LRU
     void put(Key key, Value value)
     {
       // 获取key的hash值，并计算出对应的分片索引
-      size_t sliceIndex = Hash(key) % sliceNum_;
+      size_t hash = Hash(key);
+      size_t sliceIndex = hash % sliceNum_;
       lruSliceCaches_[sliceIndex]->put(key, value);
+      bumpEpoch(hash);
     }
 
     // 查询接口 1
     bool get(Key key, Value &value)
     {
+      if (RainMrc<Key> *mrc = mrc_.load(std::memory_order_relaxed))
+        mrc->access(key);
+
       // 获取key的hash值，并计算出对应的分片索引
-      size_t sliceIndex = Hash(key) % sliceNum_;
-      return lruSliceCaches_[sliceIndex]->get(key, value);
+      size_t hash = Hash(key);
+      size_t sliceIndex = hash % sliceNum_;
+      if (!epochs_)
+        return lruSliceCaches_[sliceIndex]->get(key, value);
+
+      // 版本号在访问分片之前读取：期间若有写入，版本号已变，填入的拷贝下次就会被判为过期
+      uint64_t epoch = epochs_[epochIndex(hash)].value.load(std::memory_order_acquire);
+
+      // 近端缓存命中且版本未变时直接返回，只读共享内存
+      NearEntry *entry = nullptr;
+      if (nearCapacity_ > 0)
+      {
+        NearCache &nearCache = localNearCache();
+        entry = &nearCache.entries[hash & (nearCache.entries.size() - 1)];
+        if (entry->valid && entry->key == key && entry->epoch == epoch)
+        {
+          value = entry->value;
+          uint64_t hits = nearCache.hits.load(std::memory_order_relaxed) + 1;
+          nearCache.hits.store(hits, std::memory_order_relaxed);
+          // 按比例把命中转发给分片，热点 key 不会因为读取都落在近端而漂到分片的 LRU 尾部被淘汰
+          if (hits % kPromoteForwardInterval == 0)
+            lruSliceCaches_[sliceIndex]->touch(key);
+          return true;
+        }
+      }
+
+      bool found = hotTracker_ ? getReplicated(key, hash, epoch, value) : lruSliceCaches_[sliceIndex]->get(key, value);
+      if (found && entry)
+      {
+        entry->valid = true;
+        entry->key = key;
+        entry->value = value;
+        entry->epoch = epoch;
+      }
+      return found;
     }
 
     // 查询接口 2
@@ -322,7 +634,236 @@ namespace RainCache
       return value;
     }
 
+    // 删除指定元素
+    void remove(Key key)
+    {
+      size_t hash = Hash(key);
+      lruSliceCaches_[hash % sliceNum_]->remove(key);
+      bumpEpoch(hash);
+    }
+
+    // 开启每线程近端缓存（直接映射，每线程 entriesPerThread 个槽，向上取整为 2 的幂），需在并发访问开始前调用
+    // 每个分片带 kEpochStripes 个版本号，key 按哈希落到其中一个，put/remove 与分片淘汰之后递增它；
+    // 近端缓存中的拷贝记录填入时的版本号，版本号不同即视为过期，因此写入后任何线程都读不到旧值，
+    // 被分片淘汰的 key 也不会继续从近端命中。版本号按分片再分条，一次写入只让同一条上的拷贝失效。
+    // 近端命中不加锁、不写共享内存，也不计入分片的命中统计，命中数通过 nearCacheHits() 获取；
+    // 每个线程每 kPromoteForwardInterval 次近端命中把当次的 key 转发给分片更新一次 LRU 顺序
+    void enableNearCache(size_t entriesPerThread = 256)
+    {
+      if (nearCapacity_ > 0)
+        return;
+      nearCapacity_ = 1;
+      while (nearCapacity_ < entriesPerThread)
+      {
+        nearCapacity_ <<= 1;
+      }
+      ensureEpochs();
+    }
+
+    // 为每个分片开启或关闭有损提升，需在并发访问开始前调用
+    void setLossyPromotion(bool enabled)
+    {
+      for (auto &slice : lruSliceCaches_)
+      {
+        slice->setLossyPromotion(enabled);
+      }
+    }
+
+    // 所有线程近端缓存的命中次数
+    uint64_t nearCacheHits()
+    {
+      std::lock_guard<std::mutex> lock(nearMutex_);
+      uint64_t hits = 0;
+      for (const auto &nearCache : nearCaches_)
+      {
+        hits += nearCache->hits.load(std::memory_order_relaxed);
+      }
+      return hits;
+    }
+
+    // 开启热点检测与按核复制，需在并发访问开始前调用
+    // 每 sampleRate 次 get 采样一次交给 Space-Saving 热点检测（k 个计数器），后台线程每 refreshInterval
+    // 把估计次数下界不低于采样总数 threshold 比例的 key 选为热点；热点 key 的读取走当前 CPU 的只读副本，
+    // 副本只加共享锁，不再争抢所在分片的锁。副本条目与近端缓存一样记录版本号，put/remove 与淘汰之后自然失效；
+    // 副本命中同样每 kPromoteForwardInterval 次转发一次提升给分片
+    void enableHotReplication(size_t k = 64, double threshold = 0.01, int replicaNum = 0, int sampleRate = 16,
+                              std::chrono::milliseconds refreshInterval = std::chrono::milliseconds(100))
+    {
+      if (hotTracker_)
+        return;
+      ensureEpochs();
+      hotThreshold_ = threshold;
+      hotSampleRate_ = std::max(sampleRate, 1);
+      hotFilter_.reset(new std::atomic<uint64_t>[kHotFilterWords]);
+      for (size_t i = 0; i < kHotFilterWords; ++i)
+      {
+        hotFilter_[i].store(0, std::memory_order_relaxed);
+      }
+      int replicas = replicaNum > 0 ? replicaNum : std::max(1u, std::thread::hardware_concurrency());
+      for (int i = 0; i < replicas; ++i)
+      {
+        hotReplicas_.emplace_back(new HotReplica());
+      }
+      hotTracker_.reset(new RainTopK<Key>(k));
+
+      hotRefreshThread_ = std::thread([this, refreshInterval]()
+                                      {
+                                        std::unique_lock<std::mutex> lock(hotRefreshMutex_);
+                                        while (!hotRefreshCv_.wait_for(lock, refreshInterval, [this]()
+                                                                       { return hotRefreshStopping_; }))
+                                        {
+                                          lock.unlock();
+                                          refreshHotKeys();
+                                          lock.lock();
+                                        } });
+    }
+
+    // 当前热点检测结果，按估计次数从高到低，供运维查看
+    std::vector<HeavyHitter<Key>> hotKeys() const
+    {
+      return hotTracker_ ? hotTracker_->topK() : std::vector<HeavyHitter<Key>>();
+    }
+
+    // 重新选出热点：更新热点过滤位图，清掉副本中已不再是热点的 key，然后让检测计数衰减一半
+    // 由后台线程定期调用，也可手动调用；已有线程在刷新时直接返回
+    void refreshHotKeys()
+    {
+      if (!hotTracker_)
+        return;
+      std::unique_lock<std::mutex> lock(hotMutex_, std::try_to_lock);
+      if (!lock.owns_lock())
+        return;
+
+      uint64_t total = hotTracker_->total();
+      std::unordered_set<Key> hot;
+      std::vector<uint64_t> bits(kHotFilterWords, 0);
+      for (const HeavyHitter<Key> &hitter : hotTracker_->topK())
+      {
+        if (total == 0 || hitter.count - hitter.error < hotThreshold_ * total)
+          continue;
+        hot.insert(hitter.key);
+        size_t bit = hotFilterBit(Hash(hitter.key));
+        bits[bit / 64] |= uint64_t(1) << (bit % 64);
+      }
+      for (size_t i = 0; i < kHotFilterWords; ++i)
+      {
+        hotFilter_[i].store(bits[i], std::memory_order_relaxed);
+      }
+      for (auto &replica : hotReplicas_)
+      {
+        std::unique_lock<std::shared_mutex> replicaLock(replica->mutex);
+        for (auto it = replica->entries.begin(); it != replica->entries.end();)
+        {
+          it = hot.count(it->first) ? std::next(it) : replica->entries.erase(it);
+        }
+      }
+      hotTracker_->decay();
+    }
+
+    // 所有副本的命中次数
+    uint64_t hotReplicaHits()
+    {
+      uint64_t hits = 0;
+      for (auto &replica : hotReplicas_)
+      {
+        hits += replica->hits.load(std::memory_order_relaxed);
+      }
+      return hits;
+    }
+
+    // 所有分片的统计汇总
+    CacheStatsSnapshot stats() const
+    {
+      CacheStatsSnapshot total;
+      for (const auto &slice : lruSliceCaches_)
+      {
+        total += slice->stats();
+      }
+      return total;
+    }
+
+    // 挂接在线 MRC 估计，每次 get 都作为一次访问交给 mrc 采样，传入 nullptr 即可摘除
+    // mrc 的生命周期由调用方管理，需长于挂接期间
+    void attachMrc(RainMrc<Key> *mrc) { mrc_.store(mrc, std::memory_order_relaxed); }
+
+    // 保存快照，每个分片一个带 CRC32C 的段
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool saveSnapshot(const std::string &path)
+    {
+      return saveShardedSnapshot(path, SnapshotPolicy::LruHash, sliceNum_, [this](int i, SnapshotWriter &out)
+                                 { lruSliceCaches_[i]->template writeSnapshot<KeySerializer, ValueSerializer>(out); });
+    }
+
+    // 在 threadNum 个线程上并行校验并重建各分片，threadNum 为 0 时使用硬件并发数
+    // 分片数必须与保存时一致，否则返回 false
+    template <typename KeySerializer = SnapshotSerializer<Key>, typename ValueSerializer = SnapshotSerializer<Value>>
+    bool loadSnapshot(const std::string &path, int threadNum = 0)
+    {
+      return loadShardedSnapshot(path, SnapshotPolicy::LruHash, sliceNum_, threadNum, [this](int i, SnapshotReader &in)
+                                 { bool ok = lruSliceCaches_[i]->template readSnapshot<KeySerializer, ValueSerializer>(in);
+                                   bumpSliceEpochs(i);
+                                   return ok; });
+    }
+
+    // 为每个分片开启延迟直方图，需在并发访问开始前调用
+    void enableLatencyTracking()
+    {
+      if (!sliceLatency_.empty())
+        return;
+
+      for (int i = 0; i < sliceNum_; ++i)
+      {
+        sliceLatency_.emplace_back(new ShardLatency());
+        lruSliceCaches_[i]->setLatencyRecorder(sliceLatency_[i].get());
+      }
+    }
+
+    // 指定分片的延迟快照
+    ShardLatencySnapshot latencySnapshot(int sliceIndex) const
+    {
+      if (sliceIndex < 0 || sliceIndex >= static_cast<int>(sliceLatency_.size()))
+        return ShardLatencySnapshot();
+      return sliceLatency_[sliceIndex]->snapshot();
+    }
+
+    // 所有分片合并后的延迟快照
+    ShardLatencySnapshot latencySnapshot() const
+    {
+      ShardLatencySnapshot total;
+      for (const auto &latency : sliceLatency_)
+      {
+        total.merge(latency->snapshot());
+      }
+      return total;
+    }
+
   private:
+    static constexpr size_t kEpochStripes = 64;           // 每个分片的版本号条数
+    static constexpr uint64_t kPromoteForwardInterval = 64; // 分片之外的命中每这么多次转发一次提升
+
+    // 分片版本号，独占一条缓存行
+    struct alignas(64) SliceEpoch
+    {
+      std::atomic<uint64_t> value{0};
+    };
+
+    struct NearEntry
+    {
+      bool valid = false;
+      Key key{};
+      Value value{};
+      uint64_t epoch = 0; // 填入时分片的版本号
+    };
+
+    // 单个线程的近端缓存，只由所属线程读写；命中计数用原子变量以便汇总时读取
+    struct NearCache
+    {
+      std::vector<NearEntry> entries;
+      std::atomic<uint64_t> hits{0};
+
+      explicit NearCache(size_t capacity) : entries(capacity) {}
+    };
+
     // 将key转换为对应hash值
     size_t Hash(Key key)
     {
@@ -330,9 +871,185 @@ namespace RainCache
       return hashFunc(key);
     }
 
+    // 热点 key 在某个 CPU 上的只读副本
+    struct ReplicaEntry
+    {
+      Value value;
+      uint64_t epoch; // 填入时的版本号
+    };
+
+    // 读取只加共享锁，回填与刷新热点时独占
+    struct alignas(64) HotReplica
+    {
+      std::shared_mutex mutex;
+      std::unordered_map<Key, ReplicaEntry> entries;
+      std::atomic<uint64_t> hits{0};
+    };
+
+    static constexpr size_t kHotFilterWords = 64; // 热点过滤位图的字数（4096 位）
+
+    // 创建版本号，并让分片淘汰时递增被淘汰 key 所在条的版本号
+    void ensureEpochs()
+    {
+      if (epochs_)
+        return;
+      epochs_.reset(new SliceEpoch[sliceNum_ * kEpochStripes]);
+      for (auto &slice : lruSliceCaches_)
+      {
+        slice->setEvictionCallback([this](const Key &key, const Value &)
+                                   { bumpEpoch(Hash(key)); });
+      }
+    }
+
+    static size_t hotFilterBit(size_t hash)
+    {
+      return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ULL) >> 52);
+    }
+
+    // 位图只是提示：误判为热点的 key 只会多查一次副本，正确性由版本号保证
+    bool maybeHot(size_t hash) const
+    {
+      size_t bit = hotFilterBit(hash);
+      return (hotFilter_[bit / 64].load(std::memory_order_relaxed) >> (bit % 64)) & 1;
+    }
+
+    // 当前线程所在的 CPU，无法获取时退化为按线程编号
+    static size_t currentCpu()
+    {
+#if defined(__linux__)
+      int cpu = sched_getcpu();
+      if (cpu >= 0)
+        return static_cast<size_t>(cpu);
+#endif
+      return std::hash<std::thread::id>{}(std::this_thread::get_id());
+    }
+
+    // 采样交给热点检测，热点 key 先查本核副本，未命中再访问分片并回填副本
+    bool getReplicated(const Key &key, size_t hash, uint64_t epoch, Value &value)
+    {
+      thread_local uint64_t accesses = 0;
+      if (++accesses % hotSampleRate_ == 0)
+        hotTracker_->offer(key);
+
+      RainLru<Key, Value> &slice = *lruSliceCaches_[hash % sliceNum_];
+      if (!maybeHot(hash))
+        return slice.get(key, value);
+
+      HotReplica &replica = *hotReplicas_[currentCpu() % hotReplicas_.size()];
+      bool hit = false;
+      {
+        std::shared_lock<std::shared_mutex> lock(replica.mutex);
+        auto it = replica.entries.find(key);
+        if (it != replica.entries.end() && it->second.epoch == epoch)
+        {
+          value = it->second.value;
+          hit = true;
+        }
+      }
+      if (hit)
+      {
+        if ((replica.hits.fetch_add(1, std::memory_order_relaxed) + 1) % kPromoteForwardInterval == 0)
+          slice.touch(key);
+        return true;
+      }
+      if (!slice.get(key, value))
+        return false;
+      std::unique_lock<std::shared_mutex> lock(replica.mutex);
+      replica.entries.insert_or_assign(key, ReplicaEntry{value, epoch});
+      return true;
+    }
+
+    void stopHotRefresh()
+    {
+      {
+        std::lock_guard<std::mutex> lock(hotRefreshMutex_);
+        hotRefreshStopping_ = true;
+      }
+      hotRefreshCv_.notify_all();
+      if (hotRefreshThread_.joinable())
+        hotRefreshThread_.join();
+    }
+
+    // 同一分片的版本号连续存放，条号取分片索引之外的哈希位
+    size_t epochIndex(size_t hash) const
+    {
+      return (hash % sliceNum_) * kEpochStripes + (hash / sliceNum_) % kEpochStripes;
+    }
+
+    void bumpEpoch(size_t hash)
+    {
+      if (epochs_)
+        epochs_[epochIndex(hash)].value.fetch_add(1, std::memory_order_release);
+    }
+
+    // 整个分片被替换（如加载快照）时递增它的全部版本号
+    void bumpSliceEpochs(size_t sliceIndex)
+    {
+      if (!epochs_)
+        return;
+      for (size_t i = 0; i < kEpochStripes; ++i)
+      {
+        epochs_[sliceIndex * kEpochStripes + i].value.fetch_add(1, std::memory_order_release);
+      }
+    }
+
+    // 当前线程在本缓存上的近端缓存，第一次访问时创建并登记，由缓存对象持有
+    // 线程局部表以实例编号为 key 保存弱引用，编号不会复用；缓存析构后弱引用失效，
+    // 该线程下次创建近端缓存时一并清掉这些表项，线程局部表不会随缓存实例的创建销毁而增长
+    NearCache &localNearCache()
+    {
+      thread_local uint64_t lastId = 0;
+      thread_local NearCache *last = nullptr;
+      thread_local std::unordered_map<uint64_t, std::weak_ptr<NearCache>> nearCaches;
+      if (lastId == instanceId_)
+        return *last;
+
+      std::shared_ptr<NearCache> nearCache;
+      auto it = nearCaches.find(instanceId_);
+      if (it != nearCaches.end())
+        nearCache = it->second.lock();
+      if (!nearCache)
+      {
+        for (auto stale = nearCaches.begin(); stale != nearCaches.end();)
+        {
+          stale = stale->second.expired() ? nearCaches.erase(stale) : std::next(stale);
+        }
+        nearCache = std::make_shared<NearCache>(nearCapacity_);
+        nearCaches[instanceId_] = nearCache;
+        std::lock_guard<std::mutex> lock(nearMutex_);
+        nearCaches_.push_back(nearCache);
+      }
+      lastId = instanceId_;
+      last = nearCache.get();
+      return *last;
+    }
+
+    static uint64_t nextInstanceId()
+    {
+      static std::atomic<uint64_t> counter{0};
+      return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
   private:
     size_t capacity_;                                                  // 总容量
     int sliceNum_;                                                     // 切片数量
     std::vector<std::unique_ptr<RainLru<Key, Value>>> lruSliceCaches_; // 切片LRU缓存
+    std::unique_ptr<SliceEpoch[]> epochs_;                             // 分片版本号，开启近端缓存后才创建
+    size_t nearCapacity_ = 0;                                          // 每线程近端缓存的槽数
+    std::vector<std::shared_ptr<NearCache>> nearCaches_;               // 各线程的近端缓存，线程局部表只持有弱引用
+    std::mutex nearMutex_;                                             // 保护 nearCaches_
+    const uint64_t instanceId_ = nextInstanceId();                     // 实例编号，用于定位线程局部的近端缓存
+    std::unique_ptr<RainTopK<Key>> hotTracker_;                        // 热点检测，开启复制后才创建
+    std::unique_ptr<std::atomic<uint64_t>[]> hotFilter_;               // 热点 key 的哈希位图
+    std::vector<std::unique_ptr<HotReplica>> hotReplicas_;             // 按 CPU 划分的热点副本
+    std::mutex hotMutex_;                                              // 串行化 refreshHotKeys
+    std::thread hotRefreshThread_;                                     // 定期刷新热点的后台线程，开启复制后才启动
+    std::mutex hotRefreshMutex_;                                       // 保护 hotRefreshStopping_
+    std::condition_variable hotRefreshCv_;                             // 唤醒后台线程退出
+    bool hotRefreshStopping_ = false;                                  // 析构时通知后台线程退出
+    double hotThreshold_ = 0;                                          // 成为热点所需的采样占比
+    int hotSampleRate_ = 1;                                            // 每多少次 get 采样一次
+    std::vector<std::unique_ptr<ShardLatency>> sliceLatency_;          // 切片延迟直方图，开启后才创建
+    std::atomic<RainMrc<Key> *> mrc_{nullptr};                         // 在线 MRC 估计，未挂接时为空
   };
 } // namespace RainCache
\ No newline at end of file
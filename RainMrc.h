@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RainCache
+{
+  // 缺失率曲线（MRC）估计，基于 SHARDS (Waldspurger 等, FAST'15)
+  // 按 key 的哈希值做空间采样：hash % P < T 的 key 全部跟踪，其余直接忽略，
+  // 对采样到的访问计算 LRU 重用距离（期间访问过的不同 key 数），距离按 1/R 放大后即为原始 trace 的距离，
+  // 一次遍历即可得到任意容量下 LRU 的命中率
+  // 跟踪的 key 数量超过 maxSamples 时降低阈值 T（固定内存版 SHARDS），内存与 trace 长度无关
+  // 并发访问时采样到的哈希先写入按线程分配的条带缓冲，攒满一批后由抢到 try_lock 的线程统一合并进树状数组，
+  // 热点 key 恰好被采样时各线程也不会串行在同一把锁上；不同线程的访问按批次交错，重用距离的误差与批大小同阶
+  template <typename Key, typename Hash = std::hash<Key>>
+  class RainMrc
+  {
+  public:
+    static constexpr uint64_t kModulus = 1ULL << 24; // 采样空间 P
+    static constexpr size_t kStripeNum = 16;         // 条带缓冲数量
+    static constexpr size_t kDrainBatch = 256;       // 条带攒到这么多条时尝试合并
+    static constexpr size_t kMaxPending = 16384;     // 条带积压到这么多条时阻塞等待合并
+
+    explicit RainMrc(double samplingRate = 0.01, size_t maxSamples = 16384)
+        : threshold_(std::clamp<uint64_t>(static_cast<uint64_t>(samplingRate * kModulus), 1, kModulus)),
+          maxSamples_(std::max<size_t>(maxSamples, 1)),
+          clock_(0),
+          coldMisses_(0)
+    {
+      tree_.assign(treeSize() + 1, 0);
+    }
+
+    // 记录一次访问，未被采样的 key 只做一次哈希和比较；采样到的 key 写入本线程的条带，
+    // 攒满一批且没有其他线程在合并时才顺带合并，否则直接返回
+    void access(const Key &key)
+    {
+      uint64_t h = mix(Hash{}(key));
+      if ((h & (kModulus - 1)) >= threshold_.load(std::memory_order_relaxed))
+        return;
+
+      Stripe &s = stripe();
+      size_t pending;
+      {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.hashes.push_back(h);
+        pending = s.hashes.size();
+      }
+      if (pending < kDrainBatch)
+        return;
+
+      std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+      if (!lock.owns_lock() && pending >= kMaxPending)
+        lock.lock();
+      if (lock.owns_lock())
+        drainLocked();
+    }
+
+    // 容量为 capacity 时 LRU 的估计命中率，先合并各条带中尚未处理的采样
+    // totalAccesses 为同期的总访问数（含未采样的），给出时按 SHARDS-adj 修正热点 key 采样偏差
+    double hitRate(size_t capacity, uint64_t totalAccesses = 0)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      drainLocked();
+      return hitRateLocked(capacity, totalAccesses);
+    }
+
+    // 从 0 到 maxCapacity 均匀取 points 个容量，返回 (容量, 命中率)
+    std::vector<std::pair<size_t, double>> curve(size_t maxCapacity, size_t points, uint64_t totalAccesses = 0)
+    {
+      std::vector<std::pair<size_t, double>> result;
+      std::lock_guard<std::mutex> lock(mutex_);
+      drainLocked();
+      for (size_t i = 1; i <= points; ++i)
+      {
+        size_t capacity = maxCapacity * i / points;
+        result.emplace_back(capacity, hitRateLocked(capacity, totalAccesses));
+      }
+      return result;
+    }
+
+    // 当前采样率 R = T / P
+    double samplingRate() const
+    {
+      return static_cast<double>(threshold_.load(std::memory_order_relaxed)) / kModulus;
+    }
+
+    // 当前跟踪的采样 key 数量
+    size_t sampledKeys()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      drainLocked();
+      return samples_.size();
+    }
+
+    // 清空所有状态，采样率保持当前值
+    void reset()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (Stripe &s : stripes_)
+      {
+        std::lock_guard<std::mutex> stripeLock(s.mutex);
+        s.hashes.clear();
+      }
+      samples_.clear();
+      bySlot_.clear();
+      histogram_.clear();
+      tree_.assign(treeSize() + 1, 0);
+      clock_ = 0;
+      coldMisses_ = 0;
+    }
+
+  private:
+    struct Sample
+    {
+      uint64_t time;                                   // 最近一次访问的逻辑时间
+      std::multimap<uint64_t, uint64_t>::iterator pos; // 在 bySlot_ 中的位置
+    };
+
+    // 采样哈希的缓冲，条带之间按缓存行隔开
+    struct alignas(64) Stripe
+    {
+      std::mutex mutex;
+      std::vector<uint64_t> hashes;
+    };
+
+    // 当前线程对应的条带，线程第一次采样时按全局顺序轮转分配
+    Stripe &stripe()
+    {
+      static std::atomic<size_t> nextIndex{0};
+      static thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % kStripeNum;
+      return stripes_[index];
+    }
+
+    // 把所有条带中积压的哈希按条带内的先后顺序合并进来，调用方持有 mutex_
+    // 积压期间阈值可能已经降低，不再满足条件的哈希直接丢弃
+    void drainLocked()
+    {
+      for (Stripe &s : stripes_)
+      {
+        {
+          std::lock_guard<std::mutex> stripeLock(s.mutex);
+          drainBuffer_.swap(s.hashes);
+        }
+        for (uint64_t h : drainBuffer_)
+        {
+          if ((h & (kModulus - 1)) < threshold_.load(std::memory_order_relaxed))
+            accessSampled(h);
+        }
+        drainBuffer_.clear();
+      }
+    }
+
+    // 与分片哈希独立的混合函数，避免采样结果与分片选择相关
+    // 先加一个常数，否则恒等哈希下的 key 0 总会落在槽位 0 而必然被采样
+    static uint64_t mix(uint64_t h)
+    {
+      h += 0x9e3779b97f4a7c15ULL;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+    }
+
+    // 逻辑时间窗口大小，用完后压缩重编号
+    size_t treeSize() const { return std::max<size_t>(4 * maxSamples_, 1024); }
+
+    void accessSampled(uint64_t h)
+    {
+      if (clock_ >= treeSize())
+        compact();
+
+      auto it = samples_.find(h);
+      if (it != samples_.end())
+      {
+        // 重用距离 = 上次访问之后访问过的不同采样 key 数
+        size_t distance = samples_.size() - prefix(it->second.time);
+        if (histogram_.size() <= distance)
+          histogram_.resize(distance + 1, 0.0);
+        histogram_[distance] += 1.0;
+
+        add(it->second.time, -1);
+        it->second.time = clock_;
+        add(clock_, 1);
+      }
+      else
+      {
+        coldMisses_ += 1.0;
+        auto pos = bySlot_.emplace(h & (kModulus - 1), h);
+        samples_.emplace(h, Sample{clock_, pos});
+        add(clock_, 1);
+        if (samples_.size() > maxSamples_)
+          lowerThreshold();
+      }
+      ++clock_;
+    }
+
+    // 去掉哈希槽最大的一批 key，并把阈值降到该槽位
+    // 已有直方图按 T'/T 缩放，使其与新的采样率保持一致
+    void lowerThreshold()
+    {
+      uint64_t oldThreshold = threshold_.load(std::memory_order_relaxed);
+      uint64_t newThreshold = bySlot_.rbegin()->first;
+      while (!bySlot_.empty() && bySlot_.rbegin()->first == newThreshold)
+      {
+        auto last = std::prev(bySlot_.end());
+        auto sample = samples_.find(last->second);
+        add(sample->second.time, -1);
+        samples_.erase(sample);
+        bySlot_.erase(last);
+      }
+
+      // 距离 d 缩放后通常落在两个桶之间，按线性插值拆分，直接取整会让每次降阈值都把整条曲线左移一格
+      double ratio = static_cast<double>(newThreshold) / oldThreshold;
+      std::vector<double> rescaled(static_cast<size_t>(histogram_.size() * ratio) + 2, 0.0);
+      for (size_t d = 0; d < histogram_.size(); ++d)
+      {
+        double scaled = d * ratio;
+        size_t index = static_cast<size_t>(scaled);
+        double frac = scaled - index;
+        rescaled[index] += histogram_[d] * ratio * (1.0 - frac);
+        rescaled[index + 1] += histogram_[d] * ratio * frac;
+      }
+      histogram_.swap(rescaled);
+      coldMisses_ *= ratio;
+      threshold_.store(std::max<uint64_t>(newThreshold, 1), std::memory_order_relaxed);
+    }
+
+    // 按访问先后把逻辑时间重新编号为 0..n-1
+    void compact()
+    {
+      std::vector<std::pair<uint64_t, Sample *>> order;
+      order.reserve(samples_.size());
+      for (auto &entry : samples_)
+      {
+        order.emplace_back(entry.second.time, &entry.second);
+      }
+      std::sort(order.begin(), order.end(),
+                [](const auto &a, const auto &b)
+                { return a.first < b.first; });
+
+      tree_.assign(treeSize() + 1, 0);
+      clock_ = 0;
+      for (auto &entry : order)
+      {
+        entry.second->time = clock_;
+        add(clock_, 1);
+        ++clock_;
+      }
+    }
+
+    double hitRateLocked(size_t capacity, uint64_t totalAccesses) const
+    {
+      double total = coldMisses_;
+      for (double count : histogram_)
+      {
+        total += count;
+      }
+      if (total == 0)
+        return 0.0;
+
+      // SHARDS-adj：热点 key 是否被采样会让采样访问数偏离期望值 N*R，
+      // 差值计入距离 0 的桶（几乎都是热点 key 的重复访问）
+      double adjust = 0;
+      if (totalAccesses > 0)
+      {
+        adjust = totalAccesses * samplingRate() - total;
+        total += adjust;
+        if (total <= 0)
+          return 0.0;
+      }
+
+      // 原始距离 d 对应放大后的区间 [d/R, (d+1)/R)，落在容量边界的桶按比例计入
+      double cutoff = capacity * samplingRate();
+      size_t full = static_cast<size_t>(cutoff);
+      double hits = cutoff > 0 ? adjust : 0;
+      for (size_t d = 0; d < histogram_.size() && d < full; ++d)
+      {
+        hits += histogram_[d];
+      }
+      if (full < histogram_.size())
+        hits += histogram_[full] * (cutoff - full);
+      return std::clamp(hits / total, 0.0, 1.0);
+    }
+
+    // 树状数组：逻辑时间 time 处的计数加 delta
+    void add(uint64_t time, int delta)
+    {
+      for (size_t i = time + 1; i < tree_.size(); i += i & (~i + 1))
+      {
+        tree_[i] += delta;
+      }
+    }
+
+    // 逻辑时间 <= time 的采样 key 数
+    size_t prefix(uint64_t time) const
+    {
+      int64_t sum = 0;
+      for (size_t i = time + 1; i > 0; i -= i & (~i + 1))
+      {
+        sum += tree_[i];
+      }
+      return static_cast<size_t>(sum);
+    }
+
+  private:
+    std::atomic<uint64_t> threshold_;   // 采样阈值 T
+    size_t maxSamples_;                 // 最多跟踪的采样 key 数
+    Stripe stripes_[kStripeNum];        // 各线程写入的采样哈希
+    std::mutex mutex_;                  // 保护以下采样状态，持有时才合并条带
+    std::vector<uint64_t> drainBuffer_; // 合并时与条带交换的缓冲，保留容量复用
+
+    std::unordered_map<uint64_t, Sample> samples_; // 哈希 -> 采样 key 状态
+    std::multimap<uint64_t, uint64_t> bySlot_;     // 哈希槽 -> 哈希，用于降低阈值时找出最大槽位
+    std::vector<int64_t> tree_;                    // 按逻辑时间索引的树状数组
+    std::vector<double> histogram_;                // 重用距离直方图（采样空间内的距离）
+    uint64_t clock_;                               // 下一个逻辑时间
+    double coldMisses_;                            // 首次访问次数
+  };
+} // namespace RainCache
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "RainCache.h"
+#include "RainStaticLock.h"
+#include "RainStats.h"
+
+namespace RainCache
+{
+  // 组相联缓存：与 CPU 缓存一样，key 的哈希先选出一组 (set)，组内有 Ways 路，
+  // 每路保存 1 字节标签（哈希指纹）、1 字节年龄与 key/value，小 key/value 时一组正好占一到两条缓存行
+  // 查找时用一条 SIMD 比较同时匹配组内全部标签，再只比较标签相同的 key；
+  // 组内按年龄做精确 LRU（年龄是 0..Ways-1 的排列，0 为最近使用），淘汰只发生在组内
+  // 没有全局链表和全局锁，每组一把自旋锁，不同组的访问互不影响
+  template <typename Key, typename Value, int Ways = 8>
+  class RainSetAssoc : public RainCache<Key, Value>
+  {
+    static_assert(Ways == 8 || Ways == 16, "RainSetAssoc 的路数只支持 8 或 16");
+
+  public:
+    // 组数向上取整为 2 的幂，实际容量可能大于 capacity
+    explicit RainSetAssoc(size_t capacity)
+    {
+      setNum_ = 1;
+      while (setNum_ * Ways < capacity)
+      {
+        setNum_ <<= 1;
+      }
+      sets_.reset(new Set[setNum_]);
+    }
+
+    // 添加缓存
+    void put(Key key, Value value) override
+    {
+      stats_.recordPut();
+      size_t hash = hashKey(key);
+      Set &set = sets_[hash & (setNum_ - 1)];
+      uint8_t tag = tagOf(hash);
+      std::lock_guard<SpinLock> lock(set.lock);
+      int way = set.find(tag, key);
+      if (way < 0)
+      {
+        way = set.victim();
+        if (set.tags[way] != 0)
+          stats_.recordEviction();
+        set.tags[way] = tag;
+        set.keys[way] = key;
+      }
+      set.values[way] = value;
+      set.touch(way);
+    }
+
+    // 查询缓存，传出参数
+    bool get(Key key, Value &value) override
+    {
+      size_t hash = hashKey(key);
+      Set &set = sets_[hash & (setNum_ - 1)];
+      std::lock_guard<SpinLock> lock(set.lock);
+      int way = set.find(tagOf(hash), key);
+      if (way < 0)
+      {
+        stats_.recordMiss();
+        return false;
+      }
+      value = set.values[way];
+      set.touch(way);
+      stats_.recordHit();
+      return true;
+    }
+
+    // 查询缓存，返回值
+    Value get(Key key) override
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素
+    bool remove(const Key &key)
+    {
+      size_t hash = hashKey(key);
+      Set &set = sets_[hash & (setNum_ - 1)];
+      std::lock_guard<SpinLock> lock(set.lock);
+      int way = set.find(tagOf(hash), key);
+      if (way < 0)
+        return false;
+      set.tags[way] = 0;
+      set.keys[way] = Key();
+      set.values[way] = Value();
+      set.age(way);
+      return true;
+    }
+
+    // 是否在缓存中，不更新访问顺序，也不计入命中统计
+    bool contains(const Key &key)
+    {
+      size_t hash = hashKey(key);
+      Set &set = sets_[hash & (setNum_ - 1)];
+      std::lock_guard<SpinLock> lock(set.lock);
+      return set.find(tagOf(hash), key) >= 0;
+    }
+
+    // 当前条目数，逐组统计
+    size_t size()
+    {
+      size_t count = 0;
+      for (size_t i = 0; i < setNum_; ++i)
+      {
+        std::lock_guard<SpinLock> lock(sets_[i].lock);
+        for (int way = 0; way < Ways; ++way)
+        {
+          count += sets_[i].tags[way] != 0;
+        }
+      }
+      return count;
+    }
+
+    size_t capacity() const { return setNum_ * Ways; }
+    size_t setNum() const { return setNum_; }
+
+    // 统计快照
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+  private:
+    struct alignas(64) Set
+    {
+      SpinLock lock;
+      uint8_t tags[Ways] = {}; // 0 表示空路
+      uint8_t ages[Ways];      // 组内 LRU 排名
+      Key keys[Ways];
+      Value values[Ways];
+
+      Set()
+      {
+        for (int way = 0; way < Ways; ++way)
+        {
+          ages[way] = static_cast<uint8_t>(way);
+        }
+      }
+
+      // 标签与 key 都相同的路，未找到返回 -1
+      int find(uint8_t tag, const Key &key) const
+      {
+        uint32_t mask = matchTags(tag);
+        while (mask)
+        {
+          int way = __builtin_ctz(mask);
+          if (keys[way] == key)
+            return way;
+          mask &= mask - 1;
+        }
+        return -1;
+      }
+
+      // 一次比较组内全部标签，返回匹配位掩码
+      uint32_t matchTags(uint8_t tag) const
+      {
+#if defined(__SSE2__)
+        __m128i needle = _mm_set1_epi8(static_cast<char>(tag));
+        if constexpr (Ways == 16)
+        {
+          __m128i hay = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags));
+          return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(hay, needle)));
+        }
+        else
+        {
+          __m128i hay = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(tags));
+          return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(hay, needle))) & 0xFF;
+        }
+#elif defined(__ARM_NEON)
+        // 每个字节比较结果收缩为 4 位，再取每 4 位的最低位
+        uint8x16_t hay = Ways == 16 ? vld1q_u8(tags) : vcombine_u8(vld1_u8(tags), vdup_n_u8(0));
+        uint8x16_t eq = vceqq_u8(hay, vdupq_n_u8(tag));
+        uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        uint32_t mask = 0;
+        for (int way = 0; way < Ways; ++way)
+        {
+          mask |= static_cast<uint32_t>((nibbles >> (way * 4)) & 1) << way;
+        }
+        return mask;
+#else
+        uint32_t mask = 0;
+        for (int way = 0; way < Ways; ++way)
+        {
+          mask |= static_cast<uint32_t>(tags[way] == tag) << way;
+        }
+        return mask;
+#endif
+      }
+
+      // 置为最近使用：比它新的路年龄各加一
+      void touch(int way)
+      {
+        uint8_t old = ages[way];
+        for (int i = 0; i < Ways; ++i)
+        {
+          ages[i] += ages[i] < old;
+        }
+        ages[way] = 0;
+      }
+
+      // 置为最久未用：比它旧的路年龄各减一
+      void age(int way)
+      {
+        uint8_t old = ages[way];
+        for (int i = 0; i < Ways; ++i)
+        {
+          ages[i] -= ages[i] > old;
+        }
+        ages[way] = Ways - 1;
+      }
+
+      // 优先选空路，否则选年龄最大的路
+      int victim() const
+      {
+        int oldest = 0;
+        for (int way = 0; way < Ways; ++way)
+        {
+          if (tags[way] == 0)
+            return way;
+          if (ages[way] == Ways - 1)
+            oldest = way;
+        }
+        return oldest;
+      }
+    };
+
+    // 混合后低位选组，高 8 位作标签，标签 0 留给空路
+    static size_t hashKey(const Key &key)
+    {
+      uint64_t h = static_cast<uint64_t>(std::hash<Key>{}(key));
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<size_t>(h);
+    }
+
+    static uint8_t tagOf(size_t hash)
+    {
+      uint8_t tag = static_cast<uint8_t>(hash >> 56);
+      return tag == 0 ? 1 : tag;
+    }
+
+  private:
+    size_t setNum_;                // 组数，2 的幂
+    std::unique_ptr<Set[]> sets_;  // 全部组
+    CacheStats stats_;             // 命中/淘汰统计
+  };
+} // namespace RainCache
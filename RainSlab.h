@@ -0,0 +1,751 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "RainCache.h"
+#include "RainStats.h"
+
+namespace RainCache
+{
+  // 单个 size class 的使用情况
+  struct SlabClassStats
+  {
+    size_t chunkSize = 0;  // 每块字节数
+    size_t pages = 0;      // 持有的页数
+    size_t usedChunks = 0; // 已分配的块数
+    size_t freeChunks = 0; // 空闲块数
+  };
+
+  // memcached 风格的 slab 分配器：内存按固定大小的页申请，每页只切成一种 size class 的块，
+  // size class 按 growthFactor 递增，对象放进能装下它的最小块
+  // 页按自身大小对齐，块地址向下取整即可找到页头；不加锁，由使用者（缓存）的锁保护
+  // 页不归还系统，但可以被腾空（evacuate）后放回页池，再切给任意 class，用于重平衡与碎片整理
+  class SlabArena
+  {
+  public:
+    static constexpr size_t kPageHeaderSize = 64; // 页头占用的字节数，块从这里开始
+
+    // 页头：所属 size class、已分配块数、是否正在腾空
+    struct PageHeader
+    {
+      uint32_t cls;
+      uint32_t used;
+      uint32_t evacuating;
+    };
+
+    // memoryLimit 为最多申请的总字节数，pageSize 向上取整为 2 的幂
+    explicit SlabArena(size_t memoryLimit, size_t pageSize = 1 << 20, double growthFactor = 1.25,
+                       size_t minChunkSize = 64)
+    {
+      pageSize_ = 4096;
+      while (pageSize_ < pageSize)
+      {
+        pageSize_ <<= 1;
+      }
+      maxPages_ = std::max<size_t>(memoryLimit / pageSize_, 1);
+
+      size_t maxChunk = pageSize_ - kPageHeaderSize;
+      size_t size = roundUp(std::max<size_t>(minChunkSize, 16));
+      while (size < maxChunk)
+      {
+        classes_.emplace_back(size, (pageSize_ - kPageHeaderSize) / size);
+        size = std::max(size + 8, roundUp(static_cast<size_t>(size * std::max(growthFactor, 1.01))));
+      }
+      classes_.emplace_back(maxChunk, 1);
+    }
+
+    ~SlabArena()
+    {
+      for (SlabClass &slabClass : classes_)
+      {
+        for (char *page : slabClass.pages)
+        {
+          std::free(page);
+        }
+      }
+      for (char *page : freePages_)
+      {
+        std::free(page);
+      }
+    }
+
+    SlabArena(const SlabArena &) = delete;
+    SlabArena &operator=(const SlabArena &) = delete;
+
+    // 能容纳 size 字节的最小 size class，超过最大块时返回 -1
+    int classFor(size_t size) const
+    {
+      auto it = std::lower_bound(classes_.begin(), classes_.end(), size,
+                                 [](const SlabClass &slabClass, size_t s)
+                                 { return slabClass.chunkSize < s; });
+      return it == classes_.end() ? -1 : static_cast<int>(it - classes_.begin());
+    }
+
+    // 从指定 class 分配一块，空闲块用完且页数已达上限时返回 nullptr
+    void *allocate(int cls)
+    {
+      SlabClass &slabClass = classes_[cls];
+      if (!slabClass.freeList && !grow(cls))
+        return nullptr;
+
+      void *chunk = slabClass.freeList;
+      slabClass.freeList = *static_cast<void **>(chunk);
+      --slabClass.freeCount;
+      ++slabClass.used;
+      ++pageOf(chunk)->used;
+      return chunk;
+    }
+
+    // 归还一块，只改写块开头的 8 字节（空闲链表指针）；正在腾空的页上的块不再挂回空闲链表
+    void release(void *chunk)
+    {
+      PageHeader *page = pageOf(chunk);
+      SlabClass &slabClass = classes_[page->cls];
+      --slabClass.used;
+      --page->used;
+      if (page->evacuating)
+        return;
+      *static_cast<void **>(chunk) = slabClass.freeList;
+      slabClass.freeList = chunk;
+      ++slabClass.freeCount;
+    }
+
+    // 开始腾空一页：把它的空闲块从空闲链表摘掉，之后分配不会再落到这一页
+    void beginEvacuate(char *page)
+    {
+      PageHeader *header = reinterpret_cast<PageHeader *>(page);
+      SlabClass &slabClass = classes_[header->cls];
+      header->evacuating = 1;
+      void **link = &slabClass.freeList;
+      while (*link)
+      {
+        if (pageOf(*link) == header)
+        {
+          *link = *static_cast<void **>(*link);
+          --slabClass.freeCount;
+        }
+        else
+        {
+          link = static_cast<void **>(*link);
+        }
+      }
+    }
+
+    // 腾空完成后把页放回页池，页上仍有存活块时返回 false
+    bool finishEvacuate(char *page)
+    {
+      PageHeader *header = reinterpret_cast<PageHeader *>(page);
+      if (header->used != 0)
+        return false;
+      std::vector<char *> &pages = classes_[header->cls].pages;
+      pages.erase(std::find(pages.begin(), pages.end(), page));
+      freePages_.push_back(page);
+      return true;
+    }
+
+    // class 中存活块最少的页，没有页时返回 nullptr
+    char *sparsestPage(int cls) const
+    {
+      char *best = nullptr;
+      for (char *page : classes_[cls].pages)
+      {
+        if (!best || reinterpret_cast<PageHeader *>(page)->used < reinterpret_cast<PageHeader *>(best)->used)
+          best = page;
+      }
+      return best;
+    }
+
+    // 块所在页的页头
+    PageHeader *pageOf(const void *chunk) const
+    {
+      return reinterpret_cast<PageHeader *>(reinterpret_cast<uintptr_t>(chunk) & ~(pageSize_ - 1));
+    }
+
+    int classCount() const { return static_cast<int>(classes_.size()); }
+    size_t chunkSize(int cls) const { return classes_[cls].chunkSize; }
+    size_t chunksPerPage(int cls) const { return classes_[cls].perPage; }
+    size_t pageSize() const { return pageSize_; }
+    size_t maxPages() const { return maxPages_; }
+    size_t pagesAllocated() const { return pagesAllocated_; }
+    size_t freePages() const { return freePages_.size(); }
+
+    // 是否还能拿到新页（页池非空或未达上限）
+    bool canGrow() const { return !freePages_.empty() || pagesAllocated_ < maxPages_; }
+
+    SlabClassStats classStats(int cls) const
+    {
+      const SlabClass &slabClass = classes_[cls];
+      SlabClassStats stats;
+      stats.chunkSize = slabClass.chunkSize;
+      stats.pages = slabClass.pages.size();
+      stats.usedChunks = slabClass.used;
+      stats.freeChunks = slabClass.freeCount;
+      return stats;
+    }
+
+  private:
+    struct SlabClass
+    {
+      size_t chunkSize;         // 每块字节数
+      size_t perPage;           // 每页块数
+      std::vector<char *> pages; // 持有的页
+      void *freeList = nullptr; // 空闲块链表
+      size_t freeCount = 0;
+      size_t used = 0;
+
+      SlabClass(size_t size, size_t n) : chunkSize(size), perPage(n) {}
+    };
+
+    static size_t roundUp(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+    // 为 class 取一页（优先用页池），清零后切块挂到空闲链表
+    bool grow(int cls)
+    {
+      char *page = nullptr;
+      if (!freePages_.empty())
+      {
+        page = freePages_.back();
+        freePages_.pop_back();
+      }
+      else
+      {
+        if (pagesAllocated_ >= maxPages_)
+          return false;
+        page = static_cast<char *>(std::aligned_alloc(pageSize_, pageSize_));
+        if (!page)
+          return false;
+        ++pagesAllocated_;
+      }
+      std::memset(page, 0, pageSize_);
+
+      SlabClass &slabClass = classes_[cls];
+      reinterpret_cast<PageHeader *>(page)->cls = static_cast<uint32_t>(cls);
+      slabClass.pages.push_back(page);
+      for (size_t i = slabClass.perPage; i > 0; --i)
+      {
+        void *chunk = page + kPageHeaderSize + (i - 1) * slabClass.chunkSize;
+        *static_cast<void **>(chunk) = slabClass.freeList;
+        slabClass.freeList = chunk;
+      }
+      slabClass.freeCount += slabClass.perPage;
+      return true;
+    }
+
+  private:
+    size_t pageSize_;
+    size_t maxPages_;
+    size_t pagesAllocated_ = 0; // 向系统申请过的页数
+    std::vector<SlabClass> classes_;
+    std::vector<char *> freePages_; // 腾空后待重新分配的页
+  };
+
+  // slab 缓存的内存占用
+  struct SlabMemoryStats
+  {
+    size_t items = 0;        // 条目数
+    size_t payloadBytes = 0; // key + value 的字节数
+    size_t chunkBytes = 0;   // 条目占用的块字节数（含条目头与块内空隙）
+    size_t pageBytes = 0;    // 已申请的页字节数
+    size_t freePageBytes = 0; // 其中在页池里、尚未分给任何 class 的字节数
+    size_t indexBytes = 0;   // 哈希桶数组字节数
+
+    // 平均每个条目除 key/value 以外占用的字节数（页 + 索引）
+    double overheadPerItem() const
+    {
+      return items == 0 ? 0.0 : static_cast<double>(pageBytes + indexBytes - payloadBytes) / items;
+    }
+  };
+
+  // 字节串 LRU：key 与 value 拷贝进 SlabArena 的同一个块，条目头内嵌 LRU 与哈希链指针，
+  // 除页与哈希桶数组外不再有逐条目的堆分配，淘汰时块直接回到所属 class 的空闲链表
+  // 与 memcached 一样每个 size class 各有一条 LRU，分配失败时只淘汰同一 class 的最久未用条目
+  class RainSlabLru : public RainCache<std::string, std::string>
+  {
+  public:
+    explicit RainSlabLru(size_t memoryLimit, size_t pageSize = 1 << 20, double growthFactor = 1.25)
+        : arena_(memoryLimit, pageSize, growthFactor),
+          heads_(arena_.classCount(), nullptr),
+          tails_(arena_.classCount(), nullptr),
+          classEvictions_(arena_.classCount(), 0),
+          buckets_(1024, nullptr)
+    {
+    }
+
+    // 写入，条目超过最大块或该 class 无法腾出空间时返回 false（同 key 的旧值此时已被删除）
+    bool setBytes(std::string_view key, std::string_view value)
+    {
+      stats_.recordPut();
+      std::lock_guard<std::mutex> lock(mutex_);
+      size_t hash = hashKey(key);
+      int cls = arena_.classFor(sizeof(Item) + key.size() + value.size());
+
+      Item *item = find(key, hash);
+      if (item && static_cast<int>(item->cls) == cls)
+      {
+        // 仍在同一个 class，原地覆盖
+        payloadBytes_ += value.size();
+        payloadBytes_ -= item->valueSize;
+        item->valueSize = static_cast<uint32_t>(value.size());
+        std::memcpy(item->data() + item->keySize, value.data(), value.size());
+        unlinkLru(item);
+        linkLru(item);
+        return true;
+      }
+      if (item)
+        removeItem(item);
+      if (cls < 0)
+        return false;
+
+      void *chunk = arena_.allocate(cls);
+      while (!chunk && tails_[cls])
+      {
+        removeItem(tails_[cls]);
+        stats_.recordEviction();
+        ++classEvictions_[cls];
+        chunk = arena_.allocate(cls);
+      }
+      if (!chunk)
+      {
+        // 该 class 一页都没有时写入直接失败，同样计入压力
+        ++classEvictions_[cls];
+        return false;
+      }
+
+      item = static_cast<Item *>(chunk);
+      item->hash = hash;
+      item->keySize = static_cast<uint32_t>(key.size());
+      item->valueSize = static_cast<uint32_t>(value.size());
+      item->cls = static_cast<uint32_t>(cls);
+      item->inUse = 1;
+      std::memcpy(item->data(), key.data(), key.size());
+      std::memcpy(item->data() + key.size(), value.data(), value.size());
+      linkLru(item);
+      linkHash(item);
+      payloadBytes_ += key.size() + value.size();
+      chunkBytes_ += arena_.chunkSize(cls);
+      return true;
+    }
+
+    // 查询，命中时拷贝出 value 并移到所属 class 的 LRU 头部
+    bool getBytes(std::string_view key, std::string &value)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Item *item = find(key, hashKey(key));
+      if (!item)
+      {
+        stats_.recordMiss();
+        return false;
+      }
+
+      value.assign(item->data() + item->keySize, item->valueSize);
+      unlinkLru(item);
+      linkLru(item);
+      stats_.recordHit();
+      return true;
+    }
+
+    bool remove(std::string_view key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Item *item = find(key, hashKey(key));
+      if (!item)
+        return false;
+      removeItem(item);
+      return true;
+    }
+
+    bool contains(std::string_view key)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return find(key, hashKey(key)) != nullptr;
+    }
+
+    void put(std::string key, std::string value) override { setBytes(key, value); }
+
+    bool get(std::string key, std::string &value) override { return getBytes(key, value); }
+
+    std::string get(std::string key) override
+    {
+      std::string value;
+      getBytes(key, value);
+      return value;
+    }
+
+    size_t size()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return itemCount_;
+    }
+
+    CacheStatsSnapshot stats() const { return stats_.snapshot(); }
+
+    SlabMemoryStats memoryStats()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      SlabMemoryStats memory;
+      memory.items = itemCount_;
+      memory.payloadBytes = payloadBytes_;
+      memory.chunkBytes = chunkBytes_;
+      memory.pageBytes = arena_.pagesAllocated() * arena_.pageSize();
+      memory.freePageBytes = arena_.freePages() * arena_.pageSize();
+      memory.indexBytes = buckets_.size() * sizeof(Item *);
+      return memory;
+    }
+
+    // 指定 size class 的使用情况
+    SlabClassStats classStats(int cls)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return arena_.classStats(cls);
+    }
+
+    int classCount() const { return arena_.classCount(); }
+
+    // 重平衡一步：页都已用完时，从淘汰压力小的 class 腾出一页给淘汰最多的 class
+    // 来源优先选空闲块够一整页的 class（存活条目可以搬走而不必淘汰），否则选淘汰数不到目标一半的 class，
+    // 腾空其最稀疏的一页；每次调用后各 class 的淘汰计数减半，使压力反映最近的情况。返回是否移动了页
+    bool rebalanceStep()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      bool moved = false;
+      int dest = static_cast<int>(std::max_element(classEvictions_.begin(), classEvictions_.end()) - classEvictions_.begin());
+      if (!arena_.canGrow() && classEvictions_[dest] > 0)
+      {
+        int source = -1;
+        bool sourceHasSlack = false;
+        for (int cls = 0; cls < arena_.classCount(); ++cls)
+        {
+          SlabClassStats classStats = arena_.classStats(cls);
+          if (cls == dest || classStats.pages == 0)
+            continue;
+          bool slack = classStats.freeChunks >= arena_.chunksPerPage(cls);
+          if (slack && (!sourceHasSlack || classStats.freeChunks * classStats.chunkSize >
+                                               arena_.classStats(source).freeChunks * arena_.classStats(source).chunkSize))
+          {
+            source = cls;
+            sourceHasSlack = true;
+          }
+          else if (!sourceHasSlack && classEvictions_[cls] * 2 < classEvictions_[dest] &&
+                   (source < 0 || classEvictions_[cls] < classEvictions_[source]))
+          {
+            source = cls;
+          }
+        }
+        if (source >= 0)
+        {
+          evacuatePage(arena_.sparsestPage(source));
+          moved = true;
+        }
+      }
+
+      for (uint64_t &evictions : classEvictions_)
+      {
+        evictions /= 2;
+      }
+      return moved;
+    }
+
+    // 碎片整理一步：找一个存活条目不超过 maxMoves、且同 class 其他页的空闲块足以容纳它们的最稀疏页，
+    // 把条目搬过去并把整页放回页池，供任何 class 使用。只处理一页，返回是否回收了一页
+    bool defragStep(size_t maxMoves = 1024)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (int cls = 0; cls < arena_.classCount(); ++cls)
+      {
+        char *page = arena_.sparsestPage(cls);
+        if (!page)
+          continue;
+        size_t used = arena_.pageOf(page)->used;
+        size_t freeElsewhere = arena_.classStats(cls).freeChunks - (arena_.chunksPerPage(cls) - used);
+        if (used <= maxMoves && used <= freeElsewhere && arena_.classStats(cls).pages > 1)
+        {
+          evacuatePage(page);
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    // 条目头，key 与 value 紧随其后；prev 位于块开头，块空闲时被分配器用作空闲链表指针
+    struct Item
+    {
+      Item *prev;     // 所属 class 的 LRU 链表，头部为最近使用
+      Item *next;
+      Item *hashNext; // 哈希桶链
+      size_t hash;
+      uint32_t keySize;
+      uint32_t valueSize;
+      uint32_t cls;
+      uint8_t inUse;
+
+      char *data() { return reinterpret_cast<char *>(this + 1); }
+      std::string_view key() { return std::string_view(data(), keySize); }
+    };
+
+    static size_t hashKey(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+    Item *find(std::string_view key, size_t hash)
+    {
+      for (Item *item = buckets_[hash & (buckets_.size() - 1)]; item; item = item->hashNext)
+      {
+        if (item->hash == hash && item->key() == key)
+          return item;
+      }
+      return nullptr;
+    }
+
+    void linkHash(Item *item)
+    {
+      if (itemCount_ + 1 > buckets_.size())
+        rehash(buckets_.size() * 2);
+      Item *&bucket = buckets_[item->hash & (buckets_.size() - 1)];
+      item->hashNext = bucket;
+      bucket = item;
+      ++itemCount_;
+    }
+
+    void unlinkHash(Item *item)
+    {
+      Item **link = &buckets_[item->hash & (buckets_.size() - 1)];
+      while (*link != item)
+      {
+        link = &(*link)->hashNext;
+      }
+      *link = item->hashNext;
+      --itemCount_;
+    }
+
+    void rehash(size_t bucketNum)
+    {
+      std::vector<Item *> buckets(bucketNum, nullptr);
+      for (Item *head : buckets_)
+      {
+        while (head)
+        {
+          Item *next = head->hashNext;
+          Item *&bucket = buckets[head->hash & (bucketNum - 1)];
+          head->hashNext = bucket;
+          bucket = head;
+          head = next;
+        }
+      }
+      buckets_.swap(buckets);
+    }
+
+    void linkLru(Item *item)
+    {
+      item->prev = nullptr;
+      item->next = heads_[item->cls];
+      if (item->next)
+        item->next->prev = item;
+      else
+        tails_[item->cls] = item;
+      heads_[item->cls] = item;
+    }
+
+    void unlinkLru(Item *item)
+    {
+      if (item->prev)
+        item->prev->next = item->next;
+      else
+        heads_[item->cls] = item->next;
+      if (item->next)
+        item->next->prev = item->prev;
+      else
+        tails_[item->cls] = item->prev;
+    }
+
+    // 腾空一页：存活条目尽量搬到同 class 的其他块，搬不动的淘汰，最后整页放回页池，返回搬动的条目数
+    size_t evacuatePage(char *page)
+    {
+      arena_.beginEvacuate(page);
+      int cls = static_cast<int>(arena_.pageOf(page)->cls);
+      size_t chunkSize = arena_.chunkSize(cls);
+      size_t moved = 0;
+      for (size_t i = 0; i < arena_.chunksPerPage(cls); ++i)
+      {
+        Item *item = reinterpret_cast<Item *>(page + SlabArena::kPageHeaderSize + i * chunkSize);
+        if (!item->inUse)
+          continue;
+
+        void *chunk = arena_.allocate(cls);
+        if (chunk)
+        {
+          relocate(item, static_cast<Item *>(chunk));
+          ++moved;
+        }
+        else
+        {
+          removeItem(item);
+          stats_.recordEviction();
+        }
+      }
+      arena_.finishEvacuate(page);
+      return moved;
+    }
+
+    // 把条目整体拷贝到新块，并修正 LRU 与哈希链中指向它的指针
+    void relocate(Item *from, Item *to)
+    {
+      std::memcpy(static_cast<void *>(to), from, sizeof(Item) + from->keySize + from->valueSize);
+      if (to->prev)
+        to->prev->next = to;
+      else
+        heads_[to->cls] = to;
+      if (to->next)
+        to->next->prev = to;
+      else
+        tails_[to->cls] = to;
+
+      Item **link = &buckets_[to->hash & (buckets_.size() - 1)];
+      while (*link != from)
+      {
+        link = &(*link)->hashNext;
+      }
+      *link = to;
+
+      from->inUse = 0;
+      arena_.release(from);
+    }
+
+    // 从索引与 LRU 中摘除并归还块
+    void removeItem(Item *item)
+    {
+      unlinkHash(item);
+      unlinkLru(item);
+      payloadBytes_ -= item->keySize + item->valueSize;
+      chunkBytes_ -= arena_.chunkSize(item->cls);
+      item->inUse = 0;
+      arena_.release(item);
+    }
+
+  private:
+    std::mutex mutex_;
+    SlabArena arena_;
+    std::vector<Item *> heads_; // 每个 class 的 LRU 头
+    std::vector<Item *> tails_; // 每个 class 的 LRU 尾
+    std::vector<uint64_t> classEvictions_; // 每个 class 近期的淘汰与写入失败数，重平衡时衰减
+    std::vector<Item *> buckets_; // 哈希桶，大小为 2 的幂
+    size_t itemCount_ = 0;
+    size_t payloadBytes_ = 0;
+    size_t chunkBytes_ = 0;
+    CacheStats stats_;
+  };
+
+  // slab 字节缓存分片，每个分片有独立的锁与 SlabArena
+  // 可以开启一个后台维护线程，定期对每个分片依次做一步重平衡和一步碎片整理，每步只持有该分片的锁
+  class RainSlabLruHash
+  {
+  public:
+    explicit RainSlabLruHash(size_t memoryLimit, int sliceNum, size_t pageSize = 1 << 20, double growthFactor = 1.25)
+        : sliceNum_(sliceNum > 0 ? sliceNum : std::thread::hardware_concurrency())
+    {
+      size_t sliceLimit = memoryLimit / sliceNum_; // 每个分片的内存上限
+      for (int i = 0; i < sliceNum_; ++i)
+      {
+        slabSliceCaches_.emplace_back(new RainSlabLru(sliceLimit, pageSize, growthFactor));
+      }
+    }
+
+    ~RainSlabLruHash() { stopMaintenance(); }
+
+    bool setBytes(std::string_view key, std::string_view value) { return slice(key).setBytes(key, value); }
+    bool getBytes(std::string_view key, std::string &value) { return slice(key).getBytes(key, value); }
+    bool remove(std::string_view key) { return slice(key).remove(key); }
+
+    // 对每个分片做一步重平衡与一步碎片整理
+    void maintain(size_t maxMoves = 1024)
+    {
+      for (auto &slabSliceCache : slabSliceCaches_)
+      {
+        slabSliceCache->rebalanceStep();
+        slabSliceCache->defragStep(maxMoves);
+      }
+    }
+
+    // 启动后台维护线程，每隔 interval 调用一次 maintain
+    void startMaintenance(std::chrono::milliseconds interval = std::chrono::milliseconds(100), size_t maxMoves = 1024)
+    {
+      std::lock_guard<std::mutex> lock(maintenanceMutex_);
+      if (maintenanceThread_.joinable())
+        return;
+      stopping_ = false;
+      maintenanceThread_ = std::thread([this, interval, maxMoves]()
+                                       {
+                                         std::unique_lock<std::mutex> lock(maintenanceMutex_);
+                                         while (!maintenanceCv_.wait_for(lock, interval, [this]()
+                                                                         { return stopping_; }))
+                                         {
+                                           lock.unlock();
+                                           maintain(maxMoves);
+                                           lock.lock();
+                                         } });
+    }
+
+    void stopMaintenance()
+    {
+      {
+        std::lock_guard<std::mutex> lock(maintenanceMutex_);
+        stopping_ = true;
+      }
+      maintenanceCv_.notify_all();
+      if (maintenanceThread_.joinable())
+        maintenanceThread_.join();
+    }
+
+    CacheStatsSnapshot stats() const
+    {
+      CacheStatsSnapshot total;
+      for (const auto &slabSliceCache : slabSliceCaches_)
+      {
+        total += slabSliceCache->stats();
+      }
+      return total;
+    }
+
+    SlabMemoryStats memoryStats()
+    {
+      SlabMemoryStats total;
+      for (auto &slabSliceCache : slabSliceCaches_)
+      {
+        SlabMemoryStats memory = slabSliceCache->memoryStats();
+        total.items += memory.items;
+        total.payloadBytes += memory.payloadBytes;
+        total.chunkBytes += memory.chunkBytes;
+        total.pageBytes += memory.pageBytes;
+        total.freePageBytes += memory.freePageBytes;
+        total.indexBytes += memory.indexBytes;
+      }
+      return total;
+    }
+
+  private:
+    // 用哈希的高位选分片，低位留给分片内部的哈希桶
+    RainSlabLru &slice(std::string_view key)
+    {
+      return *slabSliceCaches_[(std::hash<std::string_view>{}(key) >> 32) % sliceNum_];
+    }
+
+  private:
+    int sliceNum_;                                            // 切片数量
+    std::vector<std::unique_ptr<RainSlabLru>> slabSliceCaches_; // 切片 slab 缓存
+
+    std::thread maintenanceThread_;             // 后台维护线程，未启动时不可 join
+    std::mutex maintenanceMutex_;
+    std::condition_variable maintenanceCv_;
+    bool stopping_ = false;
+  };
+} // namespace RainCache
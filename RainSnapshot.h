@@ -0,0 +1,501 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace RainCache
+{
+  // 快照文件格式（小端）：
+  //   magic "RCSNAP\0\0" | version u32 | policy u32 | 策略自定义的状态与条目
+  // 条目的 key/value 由序列化器写出，默认支持可平凡复制的类型和 std::string
+  // 分片缓存的快照在文件头之后是每个分片一个段，段表放在文件末尾：
+  //   文件头 | sliceNum u32 | 保留 u32 | 段 0 | 段 1 | ... | 段表 SnapshotSection[sliceNum] | 段表偏移 u64
+  inline constexpr char kSnapshotMagic[8] = {'R', 'C', 'S', 'N', 'A', 'P', '\0', '\0'};
+  inline constexpr uint32_t kSnapshotVersion = 1;
+
+  // 快照所属的缓存策略，加载时必须一致
+  enum class SnapshotPolicy : uint32_t
+  {
+    Lru = 1,
+    Lfu = 2,
+    Arc = 3,
+    ArcAdaptive = 4,
+    Car = 5,
+    LruHash = 6,
+    LfuHash = 7,
+  };
+
+  // 分片快照的段表项：段在文件中的位置、长度与 CRC32C
+  struct SnapshotSection
+  {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t crc;
+    uint32_t reserved;
+  };
+
+  namespace detail
+  {
+    // CRC32C (Castagnoli) 查表实现，没有硬件指令时使用
+    inline uint32_t crc32cTable(uint32_t crc, const unsigned char *data, size_t size)
+    {
+      static const std::array<uint32_t, 256> table = []()
+      {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+          uint32_t c = i;
+          for (int k = 0; k < 8; ++k)
+          {
+            c = (c & 1) ? (c >> 1) ^ 0x82f63b78u : c >> 1;
+          }
+          t[i] = c;
+        }
+        return t;
+      }();
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+      }
+      return crc;
+    }
+
+#if defined(__x86_64__)
+    // SSE4.2 crc32 指令每次处理 8 字节，运行时检测到 CPU 支持才会调用
+    __attribute__((target("sse4.2"))) inline uint32_t crc32cHardware(uint32_t crc, const unsigned char *data, size_t size)
+    {
+      uint64_t c = crc;
+      for (; size >= 8; size -= 8, data += 8)
+      {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        c = _mm_crc32_u64(c, word);
+      }
+      uint32_t c32 = static_cast<uint32_t>(c);
+      for (; size > 0; --size, ++data)
+      {
+        c32 = _mm_crc32_u8(c32, *data);
+      }
+      return c32;
+    }
+
+    inline bool crc32cHardwareSupported()
+    {
+      static const bool supported = __builtin_cpu_supports("sse4.2");
+      return supported;
+    }
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    inline uint32_t crc32cHardware(uint32_t crc, const unsigned char *data, size_t size)
+    {
+      for (; size >= 8; size -= 8, data += 8)
+      {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc = __crc32cd(crc, word);
+      }
+      for (; size > 0; --size, ++data)
+      {
+        crc = __crc32cb(crc, *data);
+      }
+      return crc;
+    }
+
+    inline bool crc32cHardwareSupported() { return true; }
+#else
+    inline uint32_t crc32cHardware(uint32_t crc, const unsigned char *data, size_t size)
+    {
+      return crc32cTable(crc, data, size);
+    }
+
+    inline bool crc32cHardwareSupported() { return false; }
+#endif
+  } // namespace detail
+
+  // 在 crc 的基础上继续计算 CRC32C，首次调用传 0，分段调用的结果与一次性计算相同
+  inline uint32_t crc32c(uint32_t crc, const void *data, size_t size)
+  {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+    crc = detail::crc32cHardwareSupported() ? detail::crc32cHardware(crc, bytes, size)
+                                            : detail::crc32cTable(crc, bytes, size);
+    return ~crc;
+  }
+
+  // 带缓冲的顺序写入器，先写临时文件，close 成功后再原子地重命名为目标文件
+  class SnapshotWriter
+  {
+  public:
+    static constexpr size_t kBufferSize = 1 << 20;
+
+    SnapshotWriter() = default;
+    ~SnapshotWriter()
+    {
+      if (file_)
+      {
+        std::fclose(file_);
+        std::remove(tmpPath_.c_str());
+      }
+    }
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    bool open(const std::string &path)
+    {
+      path_ = path;
+      tmpPath_ = path + ".tmp";
+      file_ = std::fopen(tmpPath_.c_str(), "wb");
+      ok_ = file_ != nullptr;
+      buffer_.reserve(kBufferSize);
+      return ok_;
+    }
+
+    void writeBytes(const void *data, size_t size)
+    {
+      if (inSection_)
+        sectionCrc_ = crc32c(sectionCrc_, data, size);
+      if (buffer_.size() + size > kBufferSize)
+        flush();
+      if (size > kBufferSize)
+      {
+        ok_ = ok_ && std::fwrite(data, 1, size, file_) == size;
+        written_ += size;
+        return;
+      }
+      const char *bytes = static_cast<const char *>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    template <typename T>
+    void writePod(const T &value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "writePod requires a trivially copyable type");
+      writeBytes(&value, sizeof(T));
+    }
+
+    // 写出文件头
+    void writeHeader(SnapshotPolicy policy)
+    {
+      writeBytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+      writePod<uint32_t>(kSnapshotVersion);
+      writePod<uint32_t>(static_cast<uint32_t>(policy));
+    }
+
+    // 刷盘并重命名，任何一步失败都返回 false，目标文件保持原样
+    bool close()
+    {
+      if (!file_)
+        return false;
+      flush();
+      ok_ = ok_ && std::fflush(file_) == 0 && ::fsync(::fileno(file_)) == 0;
+      ok_ = std::fclose(file_) == 0 && ok_;
+      file_ = nullptr;
+      if (!ok_)
+      {
+        std::remove(tmpPath_.c_str());
+        return false;
+      }
+      return std::rename(tmpPath_.c_str(), path_.c_str()) == 0;
+    }
+
+    bool ok() const { return ok_; }
+
+    // 已写出的字节数，即下一个字节在文件中的偏移
+    uint64_t offset() const { return written_ + buffer_.size(); }
+
+    // 开始一个段，之后写出的字节计入该段的 CRC32C
+    void beginSection()
+    {
+      section_ = SnapshotSection{offset(), 0, 0, 0};
+      sectionCrc_ = 0;
+      inSection_ = true;
+    }
+
+    // 结束当前段，返回它的段表项
+    SnapshotSection endSection()
+    {
+      inSection_ = false;
+      section_.size = offset() - section_.offset;
+      section_.crc = sectionCrc_;
+      return section_;
+    }
+
+  private:
+    void flush()
+    {
+      if (!buffer_.empty())
+        ok_ = ok_ && std::fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size();
+      written_ += buffer_.size();
+      buffer_.clear();
+    }
+
+  private:
+    std::FILE *file_ = nullptr;
+    std::string path_;
+    std::string tmpPath_;
+    std::vector<char> buffer_;
+    uint64_t written_ = 0; // 已写入文件的字节数
+    bool ok_ = false;
+    bool inSection_ = false;
+    SnapshotSection section_{};
+    uint32_t sectionCrc_ = 0;
+  };
+
+  // 基于 mmap 的顺序读取器，读取越界时置为失败状态而不是崩溃
+  class SnapshotReader
+  {
+  public:
+    SnapshotReader() = default;
+
+    // 只读 parent 中 [offset, offset + size) 的一段，不持有映射，parent 需比它活得久
+    SnapshotReader(const SnapshotReader &parent, uint64_t offset, uint64_t size)
+    {
+      if (parent.data_ && offset <= parent.size_ && size <= parent.size_ - offset)
+      {
+        data_ = parent.data_ + offset;
+        size_ = size;
+        ok_ = true;
+      }
+    }
+
+    ~SnapshotReader()
+    {
+      if (data_ && owner_)
+        ::munmap(const_cast<char *>(data_), size_);
+    }
+
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+    bool open(const std::string &path)
+    {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+
+      struct stat st;
+      if (::fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+        size_ = static_cast<size_t>(st.st_size);
+        void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+          data_ = static_cast<const char *>(addr);
+          owner_ = true;
+          ::madvise(addr, size_, MADV_SEQUENTIAL);
+        }
+      }
+      ::close(fd);
+      ok_ = data_ != nullptr;
+      return ok_;
+    }
+
+    bool readBytes(void *out, size_t size)
+    {
+      const char *bytes = take(size);
+      if (bytes)
+        std::memcpy(out, bytes, size);
+      return bytes != nullptr;
+    }
+
+    // 直接返回映射内存中的 size 个字节，不拷贝
+    const char *take(size_t size)
+    {
+      if (!ok_ || size_ - pos_ < size)
+      {
+        ok_ = false;
+        return nullptr;
+      }
+      const char *bytes = data_ + pos_;
+      pos_ += size;
+      return bytes;
+    }
+
+    template <typename T>
+    bool readPod(T &value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "readPod requires a trivially copyable type");
+      return readBytes(&value, sizeof(T));
+    }
+
+    // 校验文件头：魔数、版本与策略都必须一致
+    bool readHeader(SnapshotPolicy policy)
+    {
+      const char *magic = take(sizeof(kSnapshotMagic));
+      uint32_t version = 0;
+      uint32_t stored = 0;
+      if (!magic || std::memcmp(magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+          !readPod(version) || version != kSnapshotVersion ||
+          !readPod(stored) || stored != static_cast<uint32_t>(policy))
+      {
+        ok_ = false;
+      }
+      return ok_;
+    }
+
+    bool ok() const { return ok_; }
+
+    // 映射（或视图）的总字节数
+    size_t size() const { return size_; }
+
+    // 全部内容的 CRC32C
+    uint32_t checksum() const { return data_ ? crc32c(0, data_, size_) : 0; }
+
+  private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    bool ok_ = false;
+    bool owner_ = false; // 是否由自己 munmap
+  };
+
+  // ARC 系列加载快照时 T1/T2 各保留的条数，t1/t2 为读入的条数（各自已不超过 capacity）
+  // 与 REPLACE 规则一致：T1 超过目标 p 时先从 T1 裁到不低于 p，其余从 T2 裁，合计不超过 capacity
+  inline std::pair<uint64_t, uint64_t> snapshotArcSplit(uint64_t t1, uint64_t t2, uint64_t p, uint64_t capacity)
+  {
+    p = std::min(p, capacity);
+    uint64_t keepT1 = t1 > p ? std::min(t1, std::max(p, capacity > t2 ? capacity - t2 : 0)) : t1;
+    keepT1 = std::min(keepT1, capacity);
+    return {keepT1, std::min(t2, capacity - keepT1)};
+  }
+
+  // 保存分片快照：writeSlice(i, out) 写出第 i 个分片的内容，每个分片一个段
+  template <typename WriteSlice>
+  bool saveShardedSnapshot(const std::string &path, SnapshotPolicy policy, int sliceNum, WriteSlice writeSlice)
+  {
+    SnapshotWriter out;
+    if (!out.open(path))
+      return false;
+    out.writeHeader(policy);
+    out.writePod<uint32_t>(static_cast<uint32_t>(sliceNum));
+    out.writePod<uint32_t>(0);
+
+    std::vector<SnapshotSection> sections;
+    for (int i = 0; i < sliceNum; ++i)
+    {
+      out.beginSection();
+      writeSlice(i, out);
+      sections.push_back(out.endSection());
+    }
+
+    uint64_t tableOffset = out.offset();
+    out.writeBytes(sections.data(), sections.size() * sizeof(SnapshotSection));
+    out.writePod<uint64_t>(tableOffset);
+    return out.close();
+  }
+
+  // 并行加载分片快照：先并行校验所有段的 CRC32C，全部通过后再并行调用 readSlice(i, in) 重建各分片
+  // 分片数必须与保存时一致（key 按哈希对分片数取模分布）；校验失败时不修改任何分片
+  template <typename ReadSlice>
+  bool loadShardedSnapshot(const std::string &path, SnapshotPolicy policy, int sliceNum, int threadNum,
+                           ReadSlice readSlice)
+  {
+    SnapshotReader in;
+    uint32_t storedSlices = 0;
+    uint32_t reserved = 0;
+    if (!in.open(path) || !in.readHeader(policy) || !in.readPod(storedSlices) || !in.readPod(reserved) ||
+        storedSlices != static_cast<uint32_t>(sliceNum))
+      return false;
+
+    // 文件末尾的段表
+    uint64_t tableSize = static_cast<uint64_t>(sliceNum) * sizeof(SnapshotSection);
+    if (in.size() < tableSize + sizeof(uint64_t))
+      return false;
+    uint64_t tableOffset = 0;
+    SnapshotReader tail(in, in.size() - sizeof(uint64_t), sizeof(uint64_t));
+    if (!tail.readPod(tableOffset) || tableOffset + tableSize + sizeof(uint64_t) != in.size())
+      return false;
+    SnapshotReader table(in, tableOffset, tableSize);
+    std::vector<SnapshotSection> sections(sliceNum);
+    if (!table.readBytes(sections.data(), tableSize))
+      return false;
+
+    // 每个工作线程依次领取分片，phase 0 校验，phase 1 加载
+    int workerNum = std::clamp(threadNum > 0 ? threadNum : static_cast<int>(std::thread::hardware_concurrency()), 1,
+                               std::max(sliceNum, 1));
+    auto runParallel = [&](auto task)
+    {
+      std::atomic<int> next{0};
+      std::atomic<bool> ok{true};
+      std::vector<std::thread> workers;
+      for (int t = 0; t < workerNum; ++t)
+      {
+        workers.emplace_back([&]()
+                             {
+                               for (int i = next++; i < sliceNum; i = next++)
+                               {
+                                 SnapshotReader section(in, sections[i].offset, sections[i].size);
+                                 if (!task(i, section))
+                                   ok = false;
+                               } });
+      }
+      for (auto &worker : workers)
+      {
+        worker.join();
+      }
+      return ok.load();
+    };
+
+    if (!runParallel([&](int i, SnapshotReader &section)
+                     { return section.ok() && section.checksum() == sections[i].crc; }))
+      return false;
+    return runParallel([&](int i, SnapshotReader &section)
+                       { return readSlice(i, section); });
+  }
+
+  // 默认序列化器：可平凡复制的类型按内存布局直接写出
+  // 其他类型可以特化 SnapshotSerializer，或者自定义带同样静态接口的类型传给 saveSnapshot/loadSnapshot
+  template <typename T, typename Enable = void>
+  struct SnapshotSerializer
+  {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "no SnapshotSerializer for this type, please provide a specialization");
+
+    static void write(SnapshotWriter &out, const T &value) { out.writePod(value); }
+    static bool read(SnapshotReader &in, T &value) { return in.readPod(value); }
+  };
+
+  // std::string：u32 长度 + 字节
+  template <>
+  struct SnapshotSerializer<std::string>
+  {
+    static void write(SnapshotWriter &out, const std::string &value)
+    {
+      out.writePod<uint32_t>(static_cast<uint32_t>(value.size()));
+      out.writeBytes(value.data(), value.size());
+    }
+
+    static bool read(SnapshotReader &in, std::string &value)
+    {
+      uint32_t size = 0;
+      if (!in.readPod(size))
+        return false;
+      const char *bytes = in.take(size);
+      if (!bytes)
+        return false;
+      value.assign(bytes, size);
+      return true;
+    }
+  };
+} // namespace RainCache
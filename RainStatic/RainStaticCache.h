@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "RainStaticIndex.h"
+#include "RainStaticLock.h"
+#include "RainStaticPolicy.h"
+
+namespace RainCache
+{
+  // 编译期组合缓存：淘汰策略、锁、分配器、索引全部是模板参数
+  // 与 RainCache 基类不同，这里没有虚函数，整条访问路径可以被编译器内联
+  //   Policy     StaticLru / StaticLfu / StaticArc
+  //   LockPolicy NullLock / SpinLock / std::mutex / std::shared_mutex
+  //   Allocator  任意标准分配器，策略内部按需 rebind
+  //   Index      HashIndex 或其他满足 RainStaticIndex.h 中接口的索引族
+  template <typename Key, typename Value,
+            template <typename, typename, typename, typename> class Policy = StaticLru,
+            typename LockPolicy = std::mutex,
+            typename Allocator = std::allocator<Value>,
+            typename Index = HashIndex>
+  class RainStaticCache
+  {
+  public:
+    using PolicyType = Policy<Key, Value, Allocator, Index>;
+    using ReadGuard = typename LockTraits<LockPolicy>::ReadGuard;
+
+    explicit RainStaticCache(size_t capacity, const Allocator &alloc = Allocator())
+        : policy_(capacity, alloc)
+    {
+    }
+
+    // 存入缓存，索引放不下该 key（如 DenseIndex 越界）时返回 false
+    bool put(const Key &key, const Value &value)
+    {
+      std::lock_guard<LockPolicy> lock(mutex_);
+      return policy_.put(key, value);
+    }
+
+    // 查询缓存，传出参数
+    bool get(const Key &key, Value &value)
+    {
+      std::lock_guard<LockPolicy> lock(mutex_);
+      return policy_.get(key, value);
+    }
+
+    // 查询缓存，返回值
+    Value get(const Key &key)
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 删除指定元素
+    bool remove(const Key &key)
+    {
+      std::lock_guard<LockPolicy> lock(mutex_);
+      return policy_.remove(key);
+    }
+
+    // 是否存在，不更新淘汰顺序
+    bool contains(const Key &key) const
+    {
+      ReadGuard lock(mutex_);
+      return policy_.contains(key);
+    }
+
+    // 当前元素数量
+    size_t size() const
+    {
+      ReadGuard lock(mutex_);
+      return policy_.size();
+    }
+
+    size_t capacity() const { return policy_.capacity(); }
+
+  private:
+    mutable LockPolicy mutex_;
+    PolicyType policy_;
+  };
+} // namespace RainCache
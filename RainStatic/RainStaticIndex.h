@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RainCache
+{
+  // 索引族：Map<Key, Mapped, Allocator> 给出 key 到策略内部位置的映射
+  // 策略只依赖下面这组最小接口，因此可以在编译期替换索引实现
+  //   Mapped *find(const Key &)      未找到返回 nullptr
+  //   bool inBounds(const Key &) const  该 key 能否被索引，策略在分配与淘汰之前检查
+  //   void insert(const Key &, const Mapped &)  要求 inBounds(key)
+  //   void erase(const Key &)
+  //   size_t size() const
+  //   void clear()
+
+  // 默认索引：std::unordered_map，使用缓存的分配器
+  struct HashIndex
+  {
+    template <typename Key, typename Mapped, typename Allocator>
+    class Map
+    {
+    public:
+      using PairAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const Key, Mapped>>;
+      using MapType = std::unordered_map<Key, Mapped, std::hash<Key>, std::equal_to<Key>, PairAlloc>;
+
+      Map(size_t capacity, const Allocator &alloc)
+          : map_(capacity, std::hash<Key>(), std::equal_to<Key>(), PairAlloc(alloc))
+      {
+      }
+
+      Mapped *find(const Key &key)
+      {
+        auto it = map_.find(key);
+        return it == map_.end() ? nullptr : &it->second;
+      }
+
+      const Mapped *find(const Key &key) const
+      {
+        auto it = map_.find(key);
+        return it == map_.end() ? nullptr : &it->second;
+      }
+
+      bool inBounds(const Key &) const { return true; }
+      void insert(const Key &key, const Mapped &mapped) { map_.insert_or_assign(key, mapped); }
+      void erase(const Key &key) { map_.erase(key); }
+      size_t size() const { return map_.size(); }
+      void clear() { map_.clear(); }
+
+    private:
+      MapType map_;
+    };
+  };
+
+  // 稠密整数索引：key 取值在 [0, KeyBound) 内时，直接以 key 为下标存放在数组中，用位图标记是否存在
+  // 查找不需要哈希与探测；内存固定为 KeyBound 个槽，与缓存容量无关
+  // 越界的 key（含负数）inBounds 返回 false，策略的 put 直接拒绝
+  template <size_t KeyBound>
+  struct DenseIndex
+  {
+    template <typename Key, typename Mapped, typename Allocator>
+    class Map
+    {
+      static_assert(std::is_integral_v<Key> || std::is_enum_v<Key>, "DenseIndex 只支持整数或枚举 key");
+
+    public:
+      using MappedAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Mapped>;
+      using WordAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>;
+
+      Map(size_t, const Allocator &alloc)
+          : slots_(KeyBound, Mapped(), MappedAlloc(alloc)),
+            present_((KeyBound + 63) / 64, 0, WordAlloc(alloc))
+      {
+      }
+
+      Mapped *find(const Key &key)
+      {
+        size_t index = static_cast<size_t>(key);
+        return index < KeyBound && test(index) ? &slots_[index] : nullptr;
+      }
+
+      const Mapped *find(const Key &key) const
+      {
+        size_t index = static_cast<size_t>(key);
+        return index < KeyBound && test(index) ? &slots_[index] : nullptr;
+      }
+
+      bool inBounds(const Key &key) const { return static_cast<size_t>(key) < KeyBound; }
+
+      void insert(const Key &key, const Mapped &mapped)
+      {
+        size_t index = static_cast<size_t>(key);
+        if (!test(index))
+        {
+          present_[index / 64] |= uint64_t(1) << (index % 64);
+          ++size_;
+        }
+        slots_[index] = mapped;
+      }
+
+      void erase(const Key &key)
+      {
+        size_t index = static_cast<size_t>(key);
+        if (index >= KeyBound || !test(index))
+          return;
+        present_[index / 64] &= ~(uint64_t(1) << (index % 64));
+        --size_;
+      }
+
+      size_t size() const { return size_; }
+
+      void clear()
+      {
+        std::fill(present_.begin(), present_.end(), 0);
+        size_ = 0;
+      }
+
+    private:
+      bool test(size_t index) const { return (present_[index / 64] >> (index % 64)) & 1; }
+
+    private:
+      std::vector<Mapped, MappedAlloc> slots_;     // key -> 策略内部位置
+      std::vector<uint64_t, WordAlloc> present_; // 存在位图
+      size_t size_ = 0;
+    };
+  };
+} // namespace RainCache
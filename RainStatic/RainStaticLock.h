@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace RainCache
+{
+  // 空锁：单线程使用，加解锁全部内联为空操作
+  struct NullLock
+  {
+    void lock() {}
+    bool try_lock() { return true; }
+    void unlock() {}
+  };
+
+  // 自旋锁：临界区很短时比互斥锁更轻，不会让线程陷入内核
+  class SpinLock
+  {
+  public:
+    void lock()
+    {
+      while (flag_.test_and_set(std::memory_order_acquire))
+      {
+        // 只读等待，避免持续写同一缓存行
+        while (flag_.test(std::memory_order_relaxed))
+        {
+          pause();
+        }
+      }
+    }
+
+    bool try_lock()
+    {
+      return !flag_.test_and_set(std::memory_order_acquire);
+    }
+
+    void unlock()
+    {
+      flag_.clear(std::memory_order_release);
+    }
+
+  private:
+    static void pause()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#else
+      std::this_thread::yield();
+#endif
+    }
+
+  private:
+    std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+  };
+
+  // 锁类型萃取：支持 lock_shared 的锁（如 std::shared_mutex）在只读操作上使用共享锁
+  template <typename Lock, typename = void>
+  struct LockTraits
+  {
+    using ReadGuard = std::lock_guard<Lock>;
+  };
+
+  template <typename Lock>
+  struct LockTraits<Lock, std::void_t<decltype(std::declval<Lock &>().lock_shared())>>
+  {
+    using ReadGuard = std::shared_lock<Lock>;
+  };
+} // namespace RainCache
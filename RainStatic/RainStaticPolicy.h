@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "RainArcCore.h"
+
+namespace RainCache
+{
+  // 编译期淘汰策略：Policy<Key, Value, Allocator, Index>
+  // 策略本身不加锁，由 RainStaticCache 按 LockPolicy 统一加锁，接口全部为非虚函数
+  //   bool get(const Key &, Value &)          命中时更新淘汰顺序
+  //   bool put(const Key &, const Value &)   容量为 0 或索引放不下该 key 时返回 false
+  //   bool remove(const Key &)
+  //   bool contains(const Key &) const
+  //   size_t size() const / size_t capacity() const
+
+  template <typename Allocator, typename T>
+  using RebindAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  // LRU 策略：链表头部为最近访问，命中只做一次 splice
+  template <typename Key, typename Value, typename Allocator, typename Index>
+  class StaticLru
+  {
+  private:
+    struct Entry
+    {
+      Key key;
+      Value value;
+    };
+
+    using EntryList = std::list<Entry, RebindAlloc<Allocator, Entry>>;
+    using EntryIter = typename EntryList::iterator;
+    using EntryIndex = typename Index::template Map<Key, EntryIter, Allocator>;
+
+  public:
+    StaticLru(size_t capacity, const Allocator &alloc)
+        : capacity_(capacity),
+          entries_(RebindAlloc<Allocator, Entry>(alloc)),
+          index_(capacity, alloc)
+    {
+    }
+
+    bool get(const Key &key, Value &value)
+    {
+      EntryIter *pos = index_.find(key);
+      if (!pos)
+        return false;
+
+      entries_.splice(entries_.begin(), entries_, *pos);
+      value = (*pos)->value;
+      return true;
+    }
+
+    bool put(const Key &key, const Value &value)
+    {
+      if (capacity_ == 0 || !index_.inBounds(key))
+        return false;
+
+      if (EntryIter *pos = index_.find(key))
+      {
+        (*pos)->value = value;
+        entries_.splice(entries_.begin(), entries_, *pos);
+        return true;
+      }
+
+      if (entries_.size() >= capacity_)
+        evict();
+
+      entries_.push_front(Entry{key, value});
+      index_.insert(key, entries_.begin());
+      return true;
+    }
+
+    bool remove(const Key &key)
+    {
+      EntryIter *pos = index_.find(key);
+      if (!pos)
+        return false;
+
+      EntryIter entry = *pos;
+      index_.erase(key);
+      entries_.erase(entry);
+      return true;
+    }
+
+    bool contains(const Key &key) const { return index_.find(key) != nullptr; }
+    size_t size() const { return entries_.size(); }
+    size_t capacity() const { return capacity_; }
+
+  private:
+    // 淘汰链表尾部
+    void evict()
+    {
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+
+  private:
+    size_t capacity_;
+    EntryList entries_; // 头部为最近访问
+    EntryIndex index_;  // key -> 链表位置
+  };
+
+  // LFU 策略：按访问频次分链表，同频次内按先后淘汰
+  template <typename Key, typename Value, typename Allocator, typename Index>
+  class StaticLfu
+  {
+  private:
+    struct Entry
+    {
+      Key key;
+      Value value;
+      size_t freq;
+    };
+
+    using EntryAlloc = RebindAlloc<Allocator, Entry>;
+    using EntryList = std::list<Entry, EntryAlloc>;
+    using EntryIter = typename EntryList::iterator;
+    using EntryIndex = typename Index::template Map<Key, EntryIter, Allocator>;
+    using FreqMap = std::unordered_map<size_t, EntryList, std::hash<size_t>, std::equal_to<size_t>,
+                                       RebindAlloc<Allocator, std::pair<const size_t, EntryList>>>;
+
+  public:
+    StaticLfu(size_t capacity, const Allocator &alloc)
+        : capacity_(capacity),
+          size_(0),
+          minFreq_(1),
+          entryAlloc_(alloc),
+          index_(capacity, alloc),
+          freqLists_(16, std::hash<size_t>(), std::equal_to<size_t>(),
+                     RebindAlloc<Allocator, std::pair<const size_t, EntryList>>(alloc))
+    {
+    }
+
+    bool get(const Key &key, Value &value)
+    {
+      EntryIter *pos = index_.find(key);
+      if (!pos)
+        return false;
+
+      touch(*pos);
+      value = (*pos)->value;
+      return true;
+    }
+
+    bool put(const Key &key, const Value &value)
+    {
+      if (capacity_ == 0 || !index_.inBounds(key))
+        return false;
+
+      if (EntryIter *pos = index_.find(key))
+      {
+        (*pos)->value = value;
+        touch(*pos);
+        return true;
+      }
+
+      if (size_ >= capacity_)
+        evict();
+
+      EntryList &list = listFor(1);
+      list.push_back(Entry{key, value, 1});
+      index_.insert(key, std::prev(list.end()));
+      minFreq_ = 1;
+      ++size_;
+      return true;
+    }
+
+    bool remove(const Key &key)
+    {
+      EntryIter *pos = index_.find(key);
+      if (!pos)
+        return false;
+
+      EntryIter entry = *pos;
+      size_t freq = entry->freq;
+      index_.erase(key);
+      EntryList &list = freqLists_.find(freq)->second;
+      list.erase(entry);
+      --size_;
+      if (list.empty())
+      {
+        freqLists_.erase(freq);
+        if (freq == minFreq_)
+          updateMinFreq();
+      }
+      return true;
+    }
+
+    bool contains(const Key &key) const { return index_.find(key) != nullptr; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+  private:
+    // 取指定频次的链表，不存在则创建
+    EntryList &listFor(size_t freq)
+    {
+      return freqLists_.try_emplace(freq, entryAlloc_).first->second;
+    }
+
+    // 访问频次 +1，节点移动到下一频次链表尾部
+    void touch(EntryIter entry)
+    {
+      size_t freq = entry->freq;
+      // unordered_map 扩容不会使元素引用失效
+      EntryList &from = freqLists_.find(freq)->second;
+      EntryList &to = listFor(freq + 1);
+      to.splice(to.end(), from, entry);
+      ++entry->freq;
+
+      if (from.empty())
+      {
+        freqLists_.erase(freq);
+        if (freq == minFreq_)
+          minFreq_ = freq + 1;
+      }
+    }
+
+    // 淘汰最小频次链表中最早的节点
+    void evict()
+    {
+      auto it = freqLists_.find(minFreq_);
+      if (it == freqLists_.end())
+        return;
+
+      EntryList &list = it->second;
+      index_.erase(list.front().key);
+      list.pop_front();
+      --size_;
+      if (list.empty())
+        freqLists_.erase(it);
+    }
+
+    // 重新计算最小频次（只在删除任意节点时需要）
+    void updateMinFreq()
+    {
+      minFreq_ = 1;
+      if (freqLists_.empty())
+        return;
+
+      minFreq_ = freqLists_.begin()->first;
+      for (const auto &pair : freqLists_)
+      {
+        minFreq_ = std::min(minFreq_, pair.first);
+      }
+    }
+
+  private:
+    size_t capacity_;
+    size_t size_;
+    size_t minFreq_;
+    EntryAlloc entryAlloc_;
+    EntryIndex index_;  // key -> 链表位置
+    FreqMap freqLists_; // 频次 -> 该频次链表
+  };
+
+  // ARC 策略：T1/T2/B1/B2 与自适应目标 p，自适应与替换决策与 RainArcAdaptive 共用 ArcCore
+  template <typename Key, typename Value, typename Allocator, typename Index>
+  class StaticArc
+  {
+  private:
+    struct Entry
+    {
+      Key key;
+      Value value;
+      bool inT2;
+    };
+
+    using EntryList = std::list<Entry, RebindAlloc<Allocator, Entry>>;
+    using EntryIndex = typename Index::template Map<Key, typename EntryList::iterator, Allocator>;
+
+  public:
+    StaticArc(size_t capacity, const Allocator &alloc)
+        : core_(capacity, RebindAlloc<Allocator, Entry>(alloc), capacity, alloc)
+    {
+    }
+
+    bool get(const Key &key, Value &value) { return core_.get(key, value); }
+
+    bool put(const Key &key, const Value &value)
+    {
+      if (core_.capacity() == 0 || !core_.inBounds(key))
+        return false;
+
+      core_.put(key, value);
+      return true;
+    }
+
+    bool remove(const Key &key) { return core_.remove(key); }
+    bool contains(const Key &key) const { return core_.contains(key); }
+    size_t size() const { return core_.size(); }
+    size_t capacity() const { return core_.capacity(); }
+
+  private:
+    ArcCore<Key, EntryList, EntryIndex> core_;
+  };
+} // namespace RainCache
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace RainCache
+{
+  // 统计快照，由各条带计数器汇总得到
+  struct CacheStatsSnapshot
+  {
+    uint64_t hits = 0;        // 命中次数
+    uint64_t misses = 0;      // 未命中次数
+    uint64_t puts = 0;        // 写入次数
+    uint64_t evictions = 0;   // 淘汰次数
+    uint64_t ghostHits = 0;   // 幽灵列表命中次数（ARC 系列）
+    uint64_t agingEvents = 0; // 频次老化次数（LFU）
+
+    // 命中率
+    double hitRate() const
+    {
+      uint64_t lookups = hits + misses;
+      return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+
+    // 合并另一个分片的快照
+    CacheStatsSnapshot &operator+=(const CacheStatsSnapshot &other)
+    {
+      hits += other.hits;
+      misses += other.misses;
+      puts += other.puts;
+      evictions += other.evictions;
+      ghostHits += other.ghostHits;
+      agingEvents += other.agingEvents;
+      return *this;
+    }
+  };
+
+#ifndef RAINCACHE_DISABLE_STATS
+  // 条带化计数器：每个线程固定写自己的条带，条带之间按缓存行隔开，超过 kStripeNum 个线程时才会共用条带
+  // 热路径上只有一次无竞争的 relaxed 原子加，snapshot 时再把所有条带加起来
+  class CacheStats
+  {
+  public:
+    static constexpr size_t kStripeNum = 16;
+
+    void recordHit() { stripe().hits.fetch_add(1, std::memory_order_relaxed); }
+    void recordMiss() { stripe().misses.fetch_add(1, std::memory_order_relaxed); }
+    void recordPut() { stripe().puts.fetch_add(1, std::memory_order_relaxed); }
+    void recordEviction() { stripe().evictions.fetch_add(1, std::memory_order_relaxed); }
+    void recordGhostHit() { stripe().ghostHits.fetch_add(1, std::memory_order_relaxed); }
+    void recordAging() { stripe().agingEvents.fetch_add(1, std::memory_order_relaxed); }
+
+    // 汇总所有条带
+    CacheStatsSnapshot snapshot() const
+    {
+      CacheStatsSnapshot result;
+      for (const Stripe &s : stripes_)
+      {
+        result.hits += s.hits.load(std::memory_order_relaxed);
+        result.misses += s.misses.load(std::memory_order_relaxed);
+        result.puts += s.puts.load(std::memory_order_relaxed);
+        result.evictions += s.evictions.load(std::memory_order_relaxed);
+        result.ghostHits += s.ghostHits.load(std::memory_order_relaxed);
+        result.agingEvents += s.agingEvents.load(std::memory_order_relaxed);
+      }
+      return result;
+    }
+
+    // 清零
+    void reset()
+    {
+      for (Stripe &s : stripes_)
+      {
+        s.hits.store(0, std::memory_order_relaxed);
+        s.misses.store(0, std::memory_order_relaxed);
+        s.puts.store(0, std::memory_order_relaxed);
+        s.evictions.store(0, std::memory_order_relaxed);
+        s.ghostHits.store(0, std::memory_order_relaxed);
+        s.agingEvents.store(0, std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    struct alignas(64) Stripe
+    {
+      std::atomic<uint64_t> hits{0};
+      std::atomic<uint64_t> misses{0};
+      std::atomic<uint64_t> puts{0};
+      std::atomic<uint64_t> evictions{0};
+      std::atomic<uint64_t> ghostHits{0};
+      std::atomic<uint64_t> agingEvents{0};
+    };
+
+    // 当前线程对应的条带，线程第一次记录统计时按全局顺序轮转分配
+    // 前 kStripeNum 个线程各占一个条带，不会像按线程 id 取模那样随机撞到同一条带
+    Stripe &stripe()
+    {
+      static std::atomic<size_t> nextIndex{0};
+      static thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % kStripeNum;
+      return stripes_[index];
+    }
+
+  private:
+    Stripe stripes_[kStripeNum];
+  };
+#else
+  // 定义 RAINCACHE_DISABLE_STATS 后统计整体编译为空操作
+  class CacheStats
+  {
+  public:
+    void recordHit() {}
+    void recordMiss() {}
+    void recordPut() {}
+    void recordEviction() {}
+    void recordGhostHit() {}
+    void recordAging() {}
+    CacheStatsSnapshot snapshot() const { return CacheStatsSnapshot(); }
+    void reset() {}
+  };
+#endif
+} // namespace RainCache
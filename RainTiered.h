@@ -0,0 +1,711 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(RAINCACHE_WITH_URING)
+#include <liburing.h>
+#endif
+
+#include "RainCache.h"
+#include "RainLru.h"
+#include "RainSnapshot.h"
+
+namespace RainCache
+{
+  // 磁盘层记录的编解码，默认支持可平凡复制的类型和 std::string
+  template <typename T, typename Enable = void>
+  struct TierCodec
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "no TierCodec for this type, please provide a specialization");
+
+    static size_t size(const T &) { return sizeof(T); }
+    static void encode(const T &value, char *out) { std::memcpy(out, &value, sizeof(T)); }
+    static bool decode(const char *data, size_t size, T &value)
+    {
+      if (size != sizeof(T))
+        return false;
+      std::memcpy(&value, data, sizeof(T));
+      return true;
+    }
+  };
+
+  template <>
+  struct TierCodec<std::string>
+  {
+    static size_t size(const std::string &value) { return value.size(); }
+    static void encode(const std::string &value, char *out) { std::memcpy(out, value.data(), value.size()); }
+    static bool decode(const char *data, size_t size, std::string &value)
+    {
+      value.assign(data, size);
+      return true;
+    }
+  };
+
+  // 固定线程数的 pread 线程池，run 把 n 个任务分给工作线程并等待全部完成
+  class IoThreadPool
+  {
+  public:
+    explicit IoThreadPool(int threadNum)
+    {
+      for (int i = 0; i < std::max(threadNum, 1); ++i)
+      {
+        workers_.emplace_back([this]()
+                              { workerLoop(); });
+      }
+    }
+
+    ~IoThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      cv_.notify_all();
+      for (auto &worker : workers_)
+      {
+        worker.join();
+      }
+    }
+
+    IoThreadPool(const IoThreadPool &) = delete;
+    IoThreadPool &operator=(const IoThreadPool &) = delete;
+
+    void run(size_t n, const std::function<void(size_t)> &task)
+    {
+      if (n == 0)
+        return;
+
+      Batch batch{&task, n, {}};
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < n; ++i)
+      {
+        queue_.push_back({&batch, i});
+      }
+      cv_.notify_all();
+      batch.done.wait(lock, [&batch]()
+                      { return batch.remaining == 0; });
+    }
+
+  private:
+    struct Batch
+    {
+      const std::function<void(size_t)> *task;
+      size_t remaining;
+      std::condition_variable done;
+    };
+
+    struct Item
+    {
+      Batch *batch;
+      size_t index;
+    };
+
+    void workerLoop()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true)
+      {
+        cv_.wait(lock, [this]()
+                 { return stop_ || !queue_.empty(); });
+        if (queue_.empty())
+          return;
+
+        Item item = queue_.front();
+        queue_.pop_front();
+        lock.unlock();
+        (*item.batch->task)(item.index);
+        lock.lock();
+        if (--item.batch->remaining == 0)
+          item.batch->done.notify_all();
+      }
+    }
+
+  private:
+    std::vector<std::thread> workers_;
+    std::deque<Item> queue_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+  };
+
+  // 两级缓存的统计快照
+  struct TieredStatsSnapshot
+  {
+    uint64_t memoryHits = 0;   // 内存层命中
+    uint64_t diskHits = 0;     // 磁盘层命中（随后回填到内存层）
+    uint64_t misses = 0;       // 两层都未命中，需要回源
+    uint64_t diskWrites = 0;   // 写入磁盘层的记录数
+    uint64_t diskBytes = 0;    // 写入磁盘层的字节数
+    uint64_t diskDropped = 0;  // 日志回绕时被覆盖的记录数
+    uint64_t diskRejected = 0; // 读回后校验失败的记录数
+    uint64_t diskWriteFailed = 0; // 落盘失败而丢弃的记录数
+
+    double hitRate() const
+    {
+      uint64_t lookups = memoryHits + diskHits + misses;
+      return lookups == 0 ? 0.0 : static_cast<double>(memoryHits + diskHits) / lookups;
+    }
+  };
+
+  // 内存 + 本地磁盘两级缓存
+  // 内存层 Cache 淘汰的条目经淘汰回调追加到磁盘上的环形日志文件，内存中只保存 key -> 偏移的索引；
+  // 内存层未命中时从磁盘读回并回填，批量读取时用 io_uring（编译时定义 RAINCACHE_WITH_URING）
+  // 或 pread 线程池并发读盘。日志写满后回到文件开头覆盖最早的记录，即磁盘层按 FIFO 淘汰
+  // Cache 需要提供 put / get / setEvictionCallback，例如 RainLru、RainArc
+  template <typename Key, typename Value, typename Cache = RainLru<Key, Value>,
+            typename KeyCodec = TierCodec<Key>, typename ValueCodec = TierCodec<Value>>
+  class RainTiered
+  {
+  public:
+    static constexpr size_t kWriteBufferSize = 1 << 20; // 日志写缓冲大小
+    static constexpr unsigned kUringDepth = 256;         // io_uring 队列深度
+    static constexpr size_t kKeyLockStripes = 64;        // 按 key 分段的写锁数量
+
+    // memory 为内存层；path 为磁盘层日志文件，打开时清空；diskBytes 为日志文件的最大字节数
+    RainTiered(std::unique_ptr<Cache> memory, const std::string &path, uint64_t diskBytes, int ioThreads = 4)
+        : memory_(std::move(memory)),
+          diskBytes_(diskBytes),
+          ioThreads_(ioThreads)
+    {
+      fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+#if defined(RAINCACHE_WITH_URING)
+      ringInitialized_ = fd_ >= 0 && io_uring_queue_init(kUringDepth, &ring_, 0) == 0;
+      useUring_.store(ringInitialized_, std::memory_order_relaxed);
+#endif
+      writeBuffer_.reserve(kWriteBufferSize);
+      memory_->setEvictionCallback([this](const Key &key, const Value &value)
+                                   { append(key, value); });
+    }
+
+    ~RainTiered()
+    {
+      memory_->setEvictionCallback(nullptr);
+#if defined(RAINCACHE_WITH_URING)
+      if (ringInitialized_)
+        io_uring_queue_exit(&ring_);
+#endif
+      if (fd_ >= 0)
+        ::close(fd_);
+    }
+
+    RainTiered(const RainTiered &) = delete;
+    RainTiered &operator=(const RainTiered &) = delete;
+
+    // 日志文件是否打开成功，失败时退化为只有内存层
+    bool ok() const { return fd_ >= 0; }
+
+    // 写入内存层，磁盘上的旧副本随之失效
+    // 与同一 key 的磁盘回填互斥，回填前会发现索引已变化而放弃
+    void put(Key key, Value value)
+    {
+      std::lock_guard<std::mutex> keyLock(keyLockFor(key));
+      memory_->put(key, value);
+      std::lock_guard<std::mutex> lock(mutex_);
+      index_.erase(key);
+    }
+
+    // 先查内存层，未命中再查磁盘层，磁盘命中后回填到内存层
+    // 读盘期间同一 key 被 put 时返回读到的旧值，但不回填，不会覆盖新值
+    bool get(Key key, Value &value)
+    {
+      if (memory_->get(key, value))
+      {
+        ++memoryHits_;
+        return true;
+      }
+
+      ReadRequest request;
+      if (!prepareRead(key, request))
+      {
+        ++misses_;
+        return false;
+      }
+      if (!request.ready)
+        request.ok = preadFull(request.buffer.data(), request.buffer.size(), request.location.offset);
+      return finishRead(request, value);
+    }
+
+    Value get(Key key)
+    {
+      Value value{};
+      get(key, value);
+      return value;
+    }
+
+    // 批量读取，values/found 与 keys 一一对应，返回命中数量
+    // 内存层未命中的 key 一次性并发读盘，而不是逐个等待
+    size_t getBatch(const std::vector<Key> &keys, std::vector<Value> &values, std::vector<bool> &found)
+    {
+      values.assign(keys.size(), Value{});
+      found.assign(keys.size(), false);
+
+      size_t hits = 0;
+      std::vector<ReadRequest> requests;
+      std::vector<size_t> positions;
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        if (memory_->get(keys[i], values[i]))
+        {
+          ++memoryHits_;
+          found[i] = true;
+          ++hits;
+          continue;
+        }
+
+        ReadRequest request;
+        if (prepareRead(keys[i], request))
+        {
+          requests.push_back(std::move(request));
+          positions.push_back(i);
+        }
+        else
+        {
+          ++misses_;
+        }
+      }
+
+      readMany(requests);
+      for (size_t j = 0; j < requests.size(); ++j)
+      {
+        if (finishRead(requests[j], values[positions[j]]))
+        {
+          found[positions[j]] = true;
+          ++hits;
+        }
+      }
+      return hits;
+    }
+
+    // 磁盘层当前索引的记录数
+    size_t diskEntries() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return index_.size();
+    }
+
+    // 内存层
+    Cache &memory() { return *memory_; }
+
+    // 是否使用 io_uring 读盘
+    bool usingUring() const { return useUring_.load(std::memory_order_relaxed); }
+
+    TieredStatsSnapshot stats() const
+    {
+      TieredStatsSnapshot snapshot;
+      snapshot.memoryHits = memoryHits_.load(std::memory_order_relaxed);
+      snapshot.diskHits = diskHits_.load(std::memory_order_relaxed);
+      snapshot.misses = misses_.load(std::memory_order_relaxed);
+      snapshot.diskRejected = diskRejected_.load(std::memory_order_relaxed);
+      std::lock_guard<std::mutex> lock(mutex_);
+      snapshot.diskWrites = diskWrites_;
+      snapshot.diskBytes = diskBytesWritten_;
+      snapshot.diskDropped = diskDropped_;
+      snapshot.diskWriteFailed = diskWriteFailed_;
+      return snapshot;
+    }
+
+  private:
+    // 记录头：key 长度、value 长度、key+value 的 CRC32C
+    struct RecordHeader
+    {
+      uint32_t keySize;
+      uint32_t valueSize;
+      uint32_t crc;
+    };
+
+    // 一条记录在日志中的位置；generation 为追加时的全局序号，回绕后同一偏移上的新旧记录靠它区分
+    struct Location
+    {
+      uint64_t offset;
+      uint32_t size;
+      uint64_t generation;
+    };
+
+    // 日志中按写入顺序排列的记录，回绕覆盖时从队头开始失效
+    struct LogEntry
+    {
+      Location location;
+      Key key;
+    };
+
+    struct ReadRequest
+    {
+      Key key{};
+      Location location{};
+      std::vector<char> buffer;
+      bool ready = false; // 已从写缓冲拷贝，无需读盘
+      bool ok = false;
+      bool inFlight = false; // 已放入 io_uring 提交队列，尚未收割
+    };
+
+    // 淘汰回调：把记录追加到日志，由内存层在持有自身锁时调用
+    void append(const Key &key, const Value &value)
+    {
+      if (fd_ < 0)
+        return;
+
+      size_t keySize = KeyCodec::size(key);
+      size_t valueSize = ValueCodec::size(value);
+      uint64_t size = sizeof(RecordHeader) + keySize + valueSize;
+      if (size > diskBytes_ || size > kWriteBufferSize)
+        return;
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (writeOffset_ + size > diskBytes_)
+      {
+        // 文件尾部放不下，回到开头；尾部剩余的旧记录是最早写入的，一并失效
+        if (!flushLocked())
+        {
+          ++diskWriteFailed_;
+          return;
+        }
+        while (!log_.empty() && log_.front().location.offset >= writeOffset_)
+        {
+          dropFrontLocked();
+        }
+        writeOffset_ = 0;
+        bufferStart_ = 0;
+      }
+      if (writeBuffer_.size() + size > kWriteBufferSize && !flushLocked())
+      {
+        ++diskWriteFailed_;
+        return;
+      }
+
+      // 即将被覆盖的区间内的旧记录失效
+      while (!log_.empty() && log_.front().location.offset < writeOffset_ + size &&
+             log_.front().location.offset >= writeOffset_)
+      {
+        dropFrontLocked();
+      }
+
+      size_t pos = writeBuffer_.size();
+      writeBuffer_.resize(pos + size);
+      char *record = writeBuffer_.data() + pos;
+      KeyCodec::encode(key, record + sizeof(RecordHeader));
+      ValueCodec::encode(value, record + sizeof(RecordHeader) + keySize);
+      RecordHeader header{static_cast<uint32_t>(keySize), static_cast<uint32_t>(valueSize),
+                          crc32c(0, record + sizeof(RecordHeader), keySize + valueSize)};
+      std::memcpy(record, &header, sizeof(header));
+
+      Location location{writeOffset_, static_cast<uint32_t>(size), ++generation_};
+      index_[key] = location;
+      log_.push_back({location, key});
+      writeOffset_ += size;
+      ++diskWrites_;
+      diskBytesWritten_ += size;
+    }
+
+    // 写缓冲落盘，失败时未写入部分的记录从索引与日志队列中删除，返回 false
+    bool flushLocked()
+    {
+      size_t done = 0;
+      while (done < writeBuffer_.size())
+      {
+        ssize_t n = ::pwrite(fd_, writeBuffer_.data() + done, writeBuffer_.size() - done, bufferStart_ + done);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          break;
+        done += static_cast<size_t>(n);
+      }
+
+      bool ok = done == writeBuffer_.size();
+      if (!ok)
+      {
+        // 末尾不完整的记录也一并丢弃，写入位置退回到最后一条完整记录之后
+        uint64_t written = bufferStart_ + done;
+        while (!log_.empty() && log_.back().location.offset >= bufferStart_ &&
+               log_.back().location.offset + log_.back().location.size > written)
+        {
+          const LogEntry &entry = log_.back();
+          auto it = index_.find(entry.key);
+          if (it != index_.end() && it->second.offset == entry.location.offset)
+            index_.erase(it);
+          writeOffset_ = entry.location.offset;
+          ++diskWriteFailed_;
+          log_.pop_back();
+        }
+      }
+      bufferStart_ = writeOffset_;
+      writeBuffer_.clear();
+      return ok;
+    }
+
+    // 队头记录被覆盖，若索引仍指向它则删除
+    void dropFrontLocked()
+    {
+      const LogEntry &entry = log_.front();
+      auto it = index_.find(entry.key);
+      if (it != index_.end() && it->second.offset == entry.location.offset)
+      {
+        index_.erase(it);
+        ++diskDropped_;
+      }
+      log_.pop_front();
+    }
+
+    // 查索引，仍在写缓冲中的记录直接拷贝出来，否则留给调用方读盘
+    bool prepareRead(const Key &key, ReadRequest &request)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key);
+      if (it == index_.end())
+        return false;
+
+      request.key = key;
+      request.location = it->second;
+      request.buffer.resize(it->second.size);
+      if (it->second.offset >= bufferStart_ && it->second.offset < bufferStart_ + writeBuffer_.size())
+      {
+        std::memcpy(request.buffer.data(), writeBuffer_.data() + (it->second.offset - bufferStart_),
+                    it->second.size);
+        request.ready = true;
+        request.ok = true;
+      }
+      return true;
+    }
+
+    // 校验并解码读回的记录，成功后回填内存层
+    // 读盘期间该区间可能已被新记录覆盖，靠 key 与 CRC 校验识别；
+    // 只有索引仍指向读取时的同一条记录（偏移与序号都相同）才回填，否则期间有过 put 或重新淘汰，内存层的值更新
+    bool finishRead(ReadRequest &request, Value &value)
+    {
+      RecordHeader header;
+      bool valid = request.ok && request.buffer.size() >= sizeof(header);
+      if (valid)
+      {
+        std::memcpy(&header, request.buffer.data(), sizeof(header));
+        const char *payload = request.buffer.data() + sizeof(header);
+        Key key{};
+        valid = sizeof(header) + header.keySize + header.valueSize == request.buffer.size() &&
+                crc32c(0, payload, header.keySize + header.valueSize) == header.crc &&
+                KeyCodec::decode(payload, header.keySize, key) && key == request.key &&
+                ValueCodec::decode(payload + header.keySize, header.valueSize, value);
+      }
+      if (!valid)
+      {
+        ++diskRejected_;
+        ++misses_;
+        return false;
+      }
+
+      // 持有 key 的写锁，判断与回填之间不会插入同一 key 的 put
+      std::lock_guard<std::mutex> keyLock(keyLockFor(request.key));
+      bool current = false;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(request.key);
+        if (it != index_.end() && it->second.offset == request.location.offset &&
+            it->second.generation == request.location.generation)
+        {
+          index_.erase(it);
+          current = true;
+        }
+      }
+      if (current)
+        memory_->put(request.key, value);
+      ++diskHits_;
+      return true;
+    }
+
+    std::mutex &keyLockFor(const Key &key)
+    {
+      return keyLocks_[std::hash<Key>{}(key) % kKeyLockStripes];
+    }
+
+    bool preadFull(char *out, size_t size, uint64_t offset)
+    {
+      size_t done = 0;
+      while (done < size)
+      {
+        ssize_t n = ::pread(fd_, out + done, size - done, offset + done);
+        if (n <= 0)
+          return false;
+        done += static_cast<size_t>(n);
+      }
+      return true;
+    }
+
+    // 并发读取一批记录
+    void readMany(std::vector<ReadRequest> &requests)
+    {
+      std::vector<ReadRequest *> pending;
+      for (ReadRequest &request : requests)
+      {
+        if (!request.ready)
+          pending.push_back(&request);
+      }
+      if (pending.empty())
+        return;
+
+#if defined(RAINCACHE_WITH_URING)
+      if (useUring_.load(std::memory_order_acquire) && readManyUring(pending))
+        return;
+#endif
+      if (pending.size() == 1)
+      {
+        pending[0]->ok = preadFull(pending[0]->buffer.data(), pending[0]->buffer.size(), pending[0]->location.offset);
+        return;
+      }
+
+      std::call_once(poolOnce_, [this]()
+                     { pool_ = std::make_unique<IoThreadPool>(ioThreads_); });
+      pool_->run(pending.size(), [&](size_t i)
+                 { pending[i]->ok = preadFull(pending[i]->buffer.data(), pending[i]->buffer.size(),
+                                              pending[i]->location.offset); });
+    }
+
+#if defined(RAINCACHE_WITH_URING)
+    // 信号打断或完成队列已满时 io_uring_enter 返回的错误，收割后重试即可
+    static bool uringRetryable(int error)
+    {
+      return error == -EINTR || error == -EAGAIN || error == -EBUSY;
+    }
+
+    // 收割已到达的完成事件，返回收割数量；短读的请求退回 pread 补齐
+    size_t reapUring()
+    {
+      io_uring_cqe *cqe;
+      unsigned head;
+      unsigned count = 0;
+      io_uring_for_each_cqe(&ring_, head, cqe)
+      {
+        ReadRequest *request = static_cast<ReadRequest *>(io_uring_cqe_get_data(cqe));
+        if (cqe->res == static_cast<int>(request->buffer.size()))
+          request->ok = true;
+        else if (cqe->res >= 0)
+          request->ok = preadFull(request->buffer.data(), request->buffer.size(), request->location.offset);
+        request->inFlight = false;
+        ++count;
+      }
+      io_uring_cq_advance(&ring_, count);
+      return count;
+    }
+
+    // 一次提交尽可能多的读请求，收割完成事件直到全部结束；ring 已停用时返回 false，由调用方改用 pread
+    // 返回时不会有读请求仍留在内核中：可重试的错误收割后重试；其他错误则停用 io_uring，
+    // 等待已被内核接收的请求全部完成，尚未接收的请求改用 pread。停用后不再调用 submit，
+    // 留在提交队列里的 SQE 也就不会再被内核取走
+    bool readManyUring(std::vector<ReadRequest *> &pending)
+    {
+      std::lock_guard<std::mutex> lock(ringMutex_);
+      if (!useUring_.load(std::memory_order_relaxed))
+        return false;
+
+      size_t prepared = 0; // 已放入提交队列的请求数
+      size_t accepted = 0; // 已被内核接收的请求数，内核按放入顺序接收
+      size_t completed = 0;
+      bool failed = false;
+      while (completed < pending.size())
+      {
+        while (prepared < pending.size())
+        {
+          io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+          if (!sqe)
+            break;
+          ReadRequest *request = pending[prepared++];
+          io_uring_prep_read(sqe, fd_, request->buffer.data(), request->buffer.size(), request->location.offset);
+          io_uring_sqe_set_data(sqe, request);
+          request->inFlight = true;
+        }
+
+        int ret = io_uring_submit_and_wait(&ring_, 1);
+        if (ret >= 0)
+        {
+          accepted += static_cast<size_t>(ret);
+        }
+        else if (!uringRetryable(ret))
+        {
+          failed = true;
+          break;
+        }
+        completed += reapUring();
+      }
+      if (!failed)
+        return true;
+
+      useUring_.store(false, std::memory_order_release);
+      while (completed < accepted)
+      {
+        io_uring_cqe *cqe;
+        int ret = io_uring_wait_cqe(&ring_, &cqe);
+        if (ret < 0 && !uringRetryable(ret))
+          break;
+        completed += reapUring();
+      }
+      for (size_t i = 0; i < pending.size(); ++i)
+      {
+        ReadRequest *request = pending[i];
+        if (i >= accepted)
+        {
+          request->ok = preadFull(request->buffer.data(), request->buffer.size(), request->location.offset);
+        }
+        else if (request->inFlight)
+        {
+          // 连等待完成事件也失败了：缓冲区仍可能被内核写入，交给 ring 保管到析构，本次按读失败处理
+          orphanBuffers_.push_back(std::move(request->buffer));
+          request->buffer.assign(request->location.size, 0);
+          request->ok = false;
+        }
+        request->inFlight = false;
+      }
+      return true;
+    }
+#endif
+
+  private:
+    std::unique_ptr<Cache> memory_; // 内存层
+    uint64_t diskBytes_;            // 日志文件最大字节数
+    int ioThreads_;                 // pread 线程数
+    int fd_ = -1;                   // 日志文件
+    std::atomic<bool> useUring_{false}; // 是否使用 io_uring，提交失败后停用
+
+    mutable std::mutex mutex_;                 // 保护索引、日志队列与写缓冲
+    std::unordered_map<Key, Location> index_;  // key -> 磁盘上的最新副本
+    std::deque<LogEntry> log_;                 // 按写入顺序排列的记录
+    std::vector<char> writeBuffer_;            // 尚未落盘的记录
+    uint64_t bufferStart_ = 0;                 // 写缓冲第一个字节对应的文件偏移
+    uint64_t writeOffset_ = 0;                 // 下一条记录的写入位置
+    uint64_t diskWrites_ = 0;
+    uint64_t diskBytesWritten_ = 0;
+    uint64_t diskDropped_ = 0;
+    uint64_t diskWriteFailed_ = 0;
+    uint64_t generation_ = 0;                  // 追加记录的全局序号
+
+    // put 与磁盘回填按 key 分段互斥，加锁顺序为 key 锁 -> 内存层的锁 -> mutex_
+    std::array<std::mutex, kKeyLockStripes> keyLocks_;
+
+    std::atomic<uint64_t> memoryHits_{0};
+    std::atomic<uint64_t> diskHits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> diskRejected_{0};
+
+    std::once_flag poolOnce_;
+    std::unique_ptr<IoThreadPool> pool_; // 第一次批量读盘时创建
+
+#if defined(RAINCACHE_WITH_URING)
+    bool ringInitialized_ = false;
+    std::mutex ringMutex_;
+    io_uring ring_;
+    std::vector<std::vector<char>> orphanBuffers_; // 停用 ring 时仍可能被内核写入的读缓冲
+#endif
+  };
+} // namespace RainCache
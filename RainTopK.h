@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RainCache
+{
+  // 一个热点 key 的估计：真实次数落在 [count - error, count] 内
+  template <typename Key>
+  struct HeavyHitter
+  {
+    Key key;
+    uint64_t count; // 估计次数（上界）
+    uint64_t error; // 最大高估量
+  };
+
+  // Space-Saving 热点检测 (Metwally 等, ICDT'05)：固定 k 个计数器，
+  // 未跟踪的 key 到来时顶替计数最小的计数器，并继承其计数作为误差上界
+  // 次数超过总数 1/k 的 key 一定在表中；计数器按最小堆组织，每次更新 O(log k)
+  // 内部加锁；offer 只尝试加锁，锁被占用时直接丢弃这次计数，热路径上不会排队
+  template <typename Key, typename Hash = std::hash<Key>>
+  class RainTopK
+  {
+  public:
+    explicit RainTopK(size_t k = 64)
+        : k_(std::max<size_t>(k, 1))
+    {
+      counters_.reserve(k_);
+      index_.reserve(k_ * 2);
+    }
+
+    // 记录 key 出现 weight 次，返回是否计入
+    bool offer(const Key &key, uint64_t weight = 1)
+    {
+      std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+      if (!lock.owns_lock())
+        return false;
+      offerLocked(key, weight);
+      return true;
+    }
+
+    // 按估计次数从高到低返回当前全部热点
+    std::vector<HeavyHitter<Key>> topK() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<HeavyHitter<Key>> result(counters_.begin(), counters_.end());
+      std::sort(result.begin(), result.end(), [](const HeavyHitter<Key> &a, const HeavyHitter<Key> &b)
+                { return a.count > b.count; });
+      return result;
+    }
+
+    // 所有计数与误差减半，使结果反映最近的访问
+    void decay()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (HeavyHitter<Key> &counter : counters_)
+      {
+        counter.count /= 2;
+        counter.error /= 2;
+      }
+      total_ /= 2;
+    }
+
+    // 计入的总次数（随 decay 减半）
+    uint64_t total() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return total_;
+    }
+
+    size_t capacity() const { return k_; }
+
+  private:
+    void offerLocked(const Key &key, uint64_t weight)
+    {
+      total_ += weight;
+      auto it = index_.find(key);
+      if (it != index_.end())
+      {
+        counters_[it->second].count += weight;
+        siftDown(it->second);
+        return;
+      }
+
+      if (counters_.size() < k_)
+      {
+        counters_.push_back({key, weight, 0});
+        index_[key] = counters_.size() - 1;
+        siftUp(counters_.size() - 1);
+        return;
+      }
+
+      // 顶替计数最小的 key（堆顶）
+      HeavyHitter<Key> &minimum = counters_[0];
+      index_.erase(minimum.key);
+      minimum.error = minimum.count;
+      minimum.count += weight;
+      minimum.key = key;
+      index_[key] = 0;
+      siftDown(0);
+    }
+
+    void swapCounters(size_t a, size_t b)
+    {
+      std::swap(counters_[a], counters_[b]);
+      index_[counters_[a].key] = a;
+      index_[counters_[b].key] = b;
+    }
+
+    void siftUp(size_t i)
+    {
+      while (i > 0 && counters_[(i - 1) / 2].count > counters_[i].count)
+      {
+        swapCounters(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+      }
+    }
+
+    void siftDown(size_t i)
+    {
+      while (true)
+      {
+        size_t smallest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < counters_.size() && counters_[left].count < counters_[smallest].count)
+          smallest = left;
+        if (right < counters_.size() && counters_[right].count < counters_[smallest].count)
+          smallest = right;
+        if (smallest == i)
+          return;
+        swapCounters(i, smallest);
+        i = smallest;
+      }
+    }
+
+  private:
+    size_t k_;                                      // 计数器个数
+    std::vector<HeavyHitter<Key>> counters_;        // 按 count 组织的最小堆
+    std::unordered_map<Key, size_t, Hash> index_;   // key -> 堆中下标
+    uint64_t total_ = 0;                            // 计入的总次数
+    mutable std::mutex mutex_;
+  };
+} // namespace RainCache
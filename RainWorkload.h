@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace RainCache
+{
+  // 默认随机种子，测试和基准都用它保证结果可复现
+  inline constexpr uint64_t kDefaultWorkloadSeed = 42;
+
+  // xoshiro256** 随机数发生器，由 splitmix64 展开种子
+  // 比 std::mt19937 状态小、速度快，同一种子在所有平台上产生相同序列
+  class WorkloadRng
+  {
+  public:
+    explicit WorkloadRng(uint64_t seed = kDefaultWorkloadSeed)
+    {
+      for (uint64_t &s : state_)
+      {
+        seed += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        s = z ^ (z >> 31);
+      }
+    }
+
+    uint64_t next()
+    {
+      uint64_t result = rotl(state_[1] * 5, 7) * 9;
+      uint64_t t = state_[1] << 17;
+      state_[2] ^= state_[0];
+      state_[3] ^= state_[1];
+      state_[1] ^= state_[2];
+      state_[0] ^= state_[3];
+      state_[2] ^= t;
+      state_[3] = rotl(state_[3], 45);
+      return result;
+    }
+
+    // [0, n) 内的均匀整数（乘法取高位，避免取模）
+    uint64_t uniform(uint64_t n)
+    {
+      return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+
+    // [0, 1) 内的均匀浮点数
+    double nextDouble()
+    {
+      return (next() >> 11) * 0x1.0p-53;
+    }
+
+    // 以 percent% 的概率返回 true
+    bool chance(int percent)
+    {
+      return uniform(100) < static_cast<uint64_t>(percent);
+    }
+
+  private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  private:
+    uint64_t state_[4];
+  };
+
+  // key 生成器接口，可以嵌套组合
+  class KeyGenerator
+  {
+  public:
+    virtual ~KeyGenerator() = default;
+    virtual uint64_t next(WorkloadRng &rng) = 0;
+  };
+
+  using KeyGeneratorPtr = std::unique_ptr<KeyGenerator>;
+
+  // [begin, begin + count) 内均匀分布
+  class UniformKeys : public KeyGenerator
+  {
+  public:
+    UniformKeys(uint64_t begin, uint64_t count)
+        : begin_(begin), count_(std::max<uint64_t>(count, 1))
+    {
+    }
+
+    uint64_t next(WorkloadRng &rng) override { return begin_ + rng.uniform(count_); }
+
+  private:
+    uint64_t begin_;
+    uint64_t count_;
+  };
+
+  // Zipf 分布：排名 k (从 0 开始) 的概率正比于 1/(k+1)^theta
+  // 采用 rejection-inversion 采样 (Hörmann & Derflinger)，构造 O(1)，每次采样期望不到两次迭代，
+  // 不需要像 Gray 等人的方法那样预先计算 O(n) 的 zeta(n)
+  class ZipfKeys : public KeyGenerator
+  {
+  public:
+    ZipfKeys(uint64_t count, double theta, uint64_t begin = 0)
+        : begin_(begin),
+          n_(static_cast<double>(std::max<uint64_t>(count, 1))),
+          theta_(theta)
+    {
+      hIntegralX1_ = hIntegral(1.5) - 1.0;
+      hIntegralN_ = hIntegral(n_ + 0.5);
+      s_ = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    uint64_t next(WorkloadRng &rng) override { return begin_ + rank(rng); }
+
+    // 采样一个排名，范围 [0, count)
+    uint64_t rank(WorkloadRng &rng)
+    {
+      while (true)
+      {
+        double u = hIntegralN_ + rng.nextDouble() * (hIntegralX1_ - hIntegralN_);
+        double x = hIntegralInverse(u);
+        double k = std::clamp(std::floor(x + 0.5), 1.0, n_);
+        if (k - x <= s_ || u >= hIntegral(k + 0.5) - h(k))
+          return static_cast<uint64_t>(k) - 1;
+      }
+    }
+
+  private:
+    double h(double x) const { return std::exp(-theta_ * std::log(x)); }
+
+    double hIntegral(double x) const
+    {
+      double logX = std::log(x);
+      return helper2((1.0 - theta_) * logX) * logX;
+    }
+
+    double hIntegralInverse(double x) const
+    {
+      double t = std::max(x * (1.0 - theta_), -1.0);
+      return std::exp(helper1(t) * x);
+    }
+
+    // log(1+x)/x，x 接近 0 时用泰勒展开
+    static double helper1(double x)
+    {
+      return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    // (exp(x)-1)/x，x 接近 0 时用泰勒展开
+    static double helper2(double x)
+    {
+      return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+
+  private:
+    uint64_t begin_;
+    double n_;
+    double theta_;
+    double hIntegralX1_;
+    double hIntegralN_;
+    double s_;
+  };
+
+  // 在 [begin, begin + count) 内顺序循环扫描
+  class ScanKeys : public KeyGenerator
+  {
+  public:
+    ScanKeys(uint64_t begin, uint64_t count)
+        : begin_(begin), count_(std::max<uint64_t>(count, 1)), pos_(0)
+    {
+    }
+
+    uint64_t next(WorkloadRng &) override
+    {
+      uint64_t key = begin_ + pos_;
+      pos_ = (pos_ + 1) % count_;
+      return key;
+    }
+
+  private:
+    uint64_t begin_;
+    uint64_t count_;
+    uint64_t pos_;
+  };
+
+  // 热点集合平移：大小为 hotCount 的窗口内均匀访问，每 period 次访问窗口右移 stride，
+  // 共 positions 个位置后回到起点
+  class ShiftingHotSetKeys : public KeyGenerator
+  {
+  public:
+    ShiftingHotSetKeys(uint64_t begin, uint64_t hotCount, uint64_t period, uint64_t stride, uint64_t positions)
+        : begin_(begin),
+          hotCount_(std::max<uint64_t>(hotCount, 1)),
+          period_(std::max<uint64_t>(period, 1)),
+          stride_(stride),
+          positions_(std::max<uint64_t>(positions, 1)),
+          count_(0)
+    {
+    }
+
+    uint64_t next(WorkloadRng &rng) override
+    {
+      uint64_t position = (count_++ / period_) % positions_;
+      return begin_ + position * stride_ + rng.uniform(hotCount_);
+    }
+
+  private:
+    uint64_t begin_;
+    uint64_t hotCount_;
+    uint64_t period_;
+    uint64_t stride_;
+    uint64_t positions_;
+    uint64_t count_;
+  };
+
+  // 突发访问：平时由 base 生成，每 period 次访问中有 burstLength 次集中打到 burst 上
+  class BurstyKeys : public KeyGenerator
+  {
+  public:
+    BurstyKeys(KeyGeneratorPtr base, KeyGeneratorPtr burst, uint64_t period, uint64_t burstLength)
+        : base_(std::move(base)),
+          burst_(std::move(burst)),
+          period_(std::max<uint64_t>(period, 1)),
+          burstLength_(burstLength),
+          count_(0)
+    {
+    }
+
+    uint64_t next(WorkloadRng &rng) override
+    {
+      bool inBurst = count_++ % period_ >= period_ - std::min(burstLength_, period_);
+      return inBurst ? burst_->next(rng) : base_->next(rng);
+    }
+
+  private:
+    KeyGeneratorPtr base_;
+    KeyGeneratorPtr burst_;
+    uint64_t period_;
+    uint64_t burstLength_;
+    uint64_t count_;
+  };
+
+  // 按权重随机选择一个子生成器，例如 70% 热点 + 30% 冷数据
+  class MixedKeys : public KeyGenerator
+  {
+  public:
+    MixedKeys &add(int weight, KeyGeneratorPtr generator)
+    {
+      totalWeight_ += weight;
+      children_.emplace_back(totalWeight_, std::move(generator));
+      return *this;
+    }
+
+    uint64_t next(WorkloadRng &rng) override
+    {
+      uint64_t pick = rng.uniform(totalWeight_);
+      for (auto &child : children_)
+      {
+        if (pick < static_cast<uint64_t>(child.first))
+          return child.second->next(rng);
+      }
+      return children_.back().second->next(rng);
+    }
+
+  private:
+    int totalWeight_ = 0;
+    std::vector<std::pair<int, KeyGeneratorPtr>> children_; // 累计权重 -> 生成器
+  };
+
+  // value 大小分布
+  class ValueSizeDistribution
+  {
+  public:
+    // 固定大小
+    static ValueSizeDistribution fixed(uint32_t size) { return ValueSizeDistribution(size, size, 0, 0); }
+
+    // [minSize, maxSize] 内均匀分布
+    static ValueSizeDistribution uniform(uint32_t minSize, uint32_t maxSize)
+    {
+      return ValueSizeDistribution(minSize, std::max(minSize, maxSize), 0, 0);
+    }
+
+    // 双峰：largePercent% 的概率为 largeSize，其余为 smallSize（典型的小对象 + 少量大对象）
+    static ValueSizeDistribution bimodal(uint32_t smallSize, uint32_t largeSize, int largePercent)
+    {
+      return ValueSizeDistribution(smallSize, smallSize, largeSize, largePercent);
+    }
+
+    uint32_t next(WorkloadRng &rng) const
+    {
+      if (largePercent_ > 0 && rng.chance(largePercent_))
+        return largeSize_;
+      if (maxSize_ == minSize_)
+        return minSize_;
+      return minSize_ + static_cast<uint32_t>(rng.uniform(maxSize_ - minSize_ + 1));
+    }
+
+  private:
+    ValueSizeDistribution(uint32_t minSize, uint32_t maxSize, uint32_t largeSize, int largePercent)
+        : minSize_(minSize), maxSize_(maxSize), largeSize_(largeSize), largePercent_(largePercent)
+    {
+    }
+
+  private:
+    uint32_t minSize_;
+    uint32_t maxSize_;
+    uint32_t largeSize_;
+    int largePercent_;
+  };
+
+  // 一次操作
+  struct WorkloadOp
+  {
+    uint64_t key;
+    uint32_t valueSize;
+    uint32_t phase; // 所属阶段
+    bool isPut;
+  };
+
+  // 工作负载：由若干阶段组成，每个阶段有自己的 key 分布与写比例
+  class Workload
+  {
+  public:
+    explicit Workload(uint64_t seed = kDefaultWorkloadSeed,
+                      ValueSizeDistribution valueSize = ValueSizeDistribution::fixed(16))
+        : rng_(seed), valueSize_(valueSize)
+    {
+    }
+
+    // 追加一个阶段，length 次操作后进入下一阶段，最后一个阶段一直持续
+    Workload &addPhase(uint64_t length, int putPercent, KeyGeneratorPtr keys)
+    {
+      phases_.push_back({length, putPercent, std::move(keys)});
+      return *this;
+    }
+
+    // 生成下一次操作
+    WorkloadOp next()
+    {
+      while (phase_ + 1 < phases_.size() && opInPhase_ >= phases_[phase_].length)
+      {
+        ++phase_;
+        opInPhase_ = 0;
+      }
+      ++opInPhase_;
+
+      Phase &phase = phases_[phase_];
+      WorkloadOp op;
+      op.isPut = rng_.chance(phase.putPercent);
+      op.key = phase.keys->next(rng_);
+      op.valueSize = valueSize_.next(rng_);
+      op.phase = static_cast<uint32_t>(phase_);
+      return op;
+    }
+
+    // 预先生成 count 次操作，便于对多个缓存回放同一序列
+    std::vector<WorkloadOp> generate(size_t count)
+    {
+      std::vector<WorkloadOp> ops;
+      ops.reserve(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        ops.push_back(next());
+      }
+      return ops;
+    }
+
+  private:
+    struct Phase
+    {
+      uint64_t length;
+      int putPercent;
+      KeyGeneratorPtr keys;
+    };
+
+    WorkloadRng rng_;
+    ValueSizeDistribution valueSize_;
+    std::vector<Phase> phases_;
+    size_t phase_ = 0;
+    uint64_t opInPhase_ = 0;
+  };
+} // namespace RainCache
@@ -0,0 +1,405 @@
+// 多线程吞吐基准测试
+// 对每种缓存策略及分片包装类，遍历线程数、读写比例、key 分布与 value 大小，
+// 以 CSV 形式输出 Mops/s、ns/op 与扩展效率
+//
+// 用法：raincache_bench [--policies lru,lfu,...] [--threads 1,2,4] [--reads 50,90]
+//                       [--dists uniform,zipf:0.99] [--value-sizes 16,256]
+//                       [--ops 200000] [--capacity 8192] [--keys 65536] [--slices 16]
+//                       [--mrc 0.01]   给 lru-hash 挂接在线 MRC，测量采样开销
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "RainCache.h"
+#include "RainLru.h"
+#include "RainLfu.h"
+#include "RainArc.h"
+#include "RainArcAdaptive.h"
+#include "RainCar.h"
+#include "RainMrc.h"
+#include "RainSetAssoc.h"
+#include "RainWorkload.h"
+
+namespace
+{
+  using Key = uint64_t;
+  using Value = std::string;
+
+  // 统一的基准接口，所有策略经过同样一次虚调用，保证对比公平
+  class BenchCache
+  {
+  public:
+    virtual ~BenchCache() = default;
+    virtual void put(Key key, const Value &value) = 0;
+    virtual bool get(Key key, Value &value) = 0;
+  };
+
+  template <typename Cache>
+  class BenchAdapter : public BenchCache
+  {
+  public:
+    template <typename... Args>
+    explicit BenchAdapter(Args &&...args)
+        : cache_(std::forward<Args>(args)...)
+    {
+    }
+
+    void put(Key key, const Value &value) override { cache_.put(key, value); }
+
+    // RainCache 派生类经基类接口访问，与 testMain 中的调用方式保持一致
+    bool get(Key key, Value &value) override
+    {
+      if constexpr (std::is_base_of_v<RainCache::RainCache<Key, Value>, Cache>)
+        return static_cast<RainCache::RainCache<Key, Value> &>(cache_).get(key, value);
+      else
+        return cache_.get(key, value);
+    }
+
+    Cache &cache() { return cache_; }
+
+  private:
+    Cache cache_;
+  };
+
+  // 开启有损提升后再交给基准
+  template <typename Cache, typename... Args>
+  std::unique_ptr<BenchCache> makeLossy(Args &&...args)
+  {
+    auto adapter = std::make_unique<BenchAdapter<Cache>>(std::forward<Args>(args)...);
+    adapter->cache().setLossyPromotion(true);
+    return adapter;
+  }
+
+  // 挂接在线 MRC 的 RainLruHash，mrc 先于缓存构造、后于缓存析构
+  class MrcLruHashAdapter : public BenchCache
+  {
+  public:
+    MrcLruHashAdapter(size_t capacity, int sliceNum, double samplingRate)
+        : mrc_(samplingRate),
+          cache_(capacity, sliceNum)
+    {
+      cache_.attachMrc(&mrc_);
+    }
+
+    void put(Key key, const Value &value) override { cache_.put(key, value); }
+    bool get(Key key, Value &value) override { return cache_.get(key, value); }
+
+  private:
+    RainCache::RainMrc<Key> mrc_;
+    RainCache::RainLruHash<Key, Value> cache_;
+  };
+
+  struct BenchConfig
+  {
+    std::vector<std::string> policies = {"lru", "lruk", "lfu", "arc", "arc-adaptive", "car",
+                                         "lru-hash", "lfu-hash", "arc-hash", "set-assoc"};
+    std::vector<int> threads;
+    std::vector<int> readPercents = {90};
+    std::vector<std::string> dists = {"uniform", "zipf:0.99"};
+    std::vector<size_t> valueSizes = {16, 256};
+    size_t opsPerThread = 200000;
+    size_t capacity = 8192;
+    size_t keyRange = 65536;
+    int sliceNum = 16;
+    double mrcRate = 0; // 大于 0 时 lru-hash 挂接该采样率的在线 MRC
+  };
+
+  // 按名称创建缓存
+  std::unique_ptr<BenchCache> makeCache(const std::string &policy, const BenchConfig &config)
+  {
+    int capacity = static_cast<int>(config.capacity);
+    if (policy == "lru")
+      return std::make_unique<BenchAdapter<RainCache::RainLru<Key, Value>>>(capacity);
+    if (policy == "lru-lossy")
+      return makeLossy<RainCache::RainLru<Key, Value>>(capacity);
+    if (policy == "lruk")
+      return std::make_unique<BenchAdapter<RainCache::RainLruK<Key, Value>>>(capacity, capacity * 2, 2);
+    if (policy == "lfu")
+      return std::make_unique<BenchAdapter<RainCache::RainLfu<Key, Value>>>(capacity);
+    if (policy == "arc")
+      return std::make_unique<BenchAdapter<RainCache::RainArc<Key, Value>>>(config.capacity);
+    if (policy == "arc-adaptive")
+      return std::make_unique<BenchAdapter<RainCache::RainArcAdaptive<Key, Value>>>(config.capacity);
+    if (policy == "car")
+      return std::make_unique<BenchAdapter<RainCache::RainCar<Key, Value>>>(config.capacity);
+    if (policy == "lru-hash" && config.mrcRate > 0)
+      return std::make_unique<MrcLruHashAdapter>(config.capacity, config.sliceNum, config.mrcRate);
+    if (policy == "lru-hash")
+      return std::make_unique<BenchAdapter<RainCache::RainLruHash<Key, Value>>>(config.capacity, config.sliceNum);
+    if (policy == "lru-hash-lossy")
+      return makeLossy<RainCache::RainLruHash<Key, Value>>(config.capacity, config.sliceNum);
+    if (policy == "lfu-hash")
+      return std::make_unique<BenchAdapter<RainCache::RainLfuHash<Key, Value>>>(config.capacity, config.sliceNum);
+    if (policy == "arc-hash")
+      return std::make_unique<BenchAdapter<RainCache::RainArcHash<Key, Value>>>(config.capacity, config.sliceNum);
+    if (policy == "set-assoc")
+      return std::make_unique<BenchAdapter<RainCache::RainSetAssoc<Key, Value>>>(config.capacity);
+    return nullptr;
+  }
+
+  // 预先生成每个线程的操作序列，避免生成开销计入吞吐
+  struct Operation
+  {
+    Key key;
+    bool isGet;
+  };
+
+  std::vector<Operation> makeOperations(const BenchConfig &config, const std::string &dist,
+                                        int readPercent, uint64_t seed)
+  {
+    RainCache::WorkloadRng rng(seed);
+    std::vector<Operation> ops(config.opsPerThread);
+
+    std::unique_ptr<RainCache::KeyGenerator> keys;
+    if (dist.rfind("zipf", 0) == 0)
+    {
+      double theta = dist.size() > 5 ? std::stod(dist.substr(5)) : 0.99;
+      keys = std::make_unique<RainCache::ZipfKeys>(config.keyRange, theta);
+    }
+    else
+    {
+      keys = std::make_unique<RainCache::UniformKeys>(0, config.keyRange);
+    }
+
+    for (Operation &op : ops)
+    {
+      Key rank = keys->next(rng);
+      // 打散热点 key，避免热点集中在相邻的分片
+      op.key = rank * 0x9E3779B97F4A7C15ULL;
+      op.isGet = rng.chance(readPercent);
+    }
+    return ops;
+  }
+
+  struct BenchResult
+  {
+    double seconds = 0;
+    uint64_t totalOps = 0;
+    uint64_t gets = 0;
+    uint64_t hits = 0;
+  };
+
+  BenchResult runOnce(BenchCache &cache, const std::vector<std::vector<Operation>> &threadOps,
+                      const Value &value)
+  {
+    int threadNum = static_cast<int>(threadOps.size());
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<uint64_t> gets(threadNum, 0);
+    std::vector<uint64_t> hits(threadNum, 0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadNum; ++t)
+    {
+      threads.emplace_back([&, t]()
+                           {
+        const std::vector<Operation> &ops = threadOps[t];
+        Value result;
+        uint64_t localGets = 0;
+        uint64_t localHits = 0;
+
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire))
+        {
+          std::this_thread::yield();
+        }
+
+        for (const Operation &op : ops)
+        {
+          if (op.isGet)
+          {
+            ++localGets;
+            if (cache.get(op.key, result))
+              ++localHits;
+          }
+          else
+          {
+            cache.put(op.key, value);
+          }
+        }
+        gets[t] = localGets;
+        hits[t] = localHits; });
+    }
+
+    while (ready.load() < threadNum)
+    {
+      std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    BenchResult result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    for (int t = 0; t < threadNum; ++t)
+    {
+      result.totalOps += threadOps[t].size();
+      result.gets += gets[t];
+      result.hits += hits[t];
+    }
+    return result;
+  }
+
+  std::vector<std::string> splitList(const std::string &text)
+  {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+      if (!item.empty())
+        items.push_back(item);
+    }
+    return items;
+  }
+
+  void printUsage()
+  {
+    std::cerr << "usage: raincache_bench [--policies lru,lruk,lfu,arc,arc-adaptive,car,lru-hash,lfu-hash,arc-hash,set-assoc,\n"
+              << "                                   lru-lossy,lru-hash-lossy]\n"
+              << "                       [--threads 1,2,4,8] [--reads 50,90,100] [--dists uniform,zipf:0.99]\n"
+              << "                       [--value-sizes 16,256] [--ops N] [--capacity N] [--keys N] [--slices N]\n"
+              << "                       [--mrc SAMPLING_RATE]\n";
+  }
+
+  bool parseArgs(int argc, char **argv, BenchConfig &config)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string arg = argv[i];
+      if (arg == "--help" || arg == "-h" || i + 1 >= argc)
+        return false;
+
+      std::string value = argv[++i];
+      if (arg == "--policies")
+        config.policies = splitList(value);
+      else if (arg == "--threads")
+      {
+        config.threads.clear();
+        for (const std::string &item : splitList(value))
+          config.threads.push_back(std::stoi(item));
+      }
+      else if (arg == "--reads")
+      {
+        config.readPercents.clear();
+        for (const std::string &item : splitList(value))
+          config.readPercents.push_back(std::stoi(item));
+      }
+      else if (arg == "--dists")
+        config.dists = splitList(value);
+      else if (arg == "--value-sizes")
+      {
+        config.valueSizes.clear();
+        for (const std::string &item : splitList(value))
+          config.valueSizes.push_back(std::stoul(item));
+      }
+      else if (arg == "--ops")
+        config.opsPerThread = std::stoul(value);
+      else if (arg == "--capacity")
+        config.capacity = std::stoul(value);
+      else if (arg == "--keys")
+        config.keyRange = std::stoul(value);
+      else if (arg == "--slices")
+        config.sliceNum = std::stoi(value);
+      else if (arg == "--mrc")
+        config.mrcRate = std::stod(value);
+      else
+        return false;
+    }
+
+    // 每线程至少一次操作，否则生成的访问序列为空，无法取模和计算吞吐
+    if (config.opsPerThread == 0)
+      return false;
+
+    // 默认线程数：1, 2, 4 ... 直到硬件并发数
+    if (config.threads.empty())
+    {
+      int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+      for (int t = 1; t < maxThreads; t *= 2)
+        config.threads.push_back(t);
+      config.threads.push_back(maxThreads);
+    }
+    return true;
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  BenchConfig config;
+  if (!parseArgs(argc, argv, config))
+  {
+    printUsage();
+    return 1;
+  }
+
+  std::cout << "policy,threads,read_pct,dist,value_size,ops,seconds,mops,ns_per_op,scaling_efficiency,hit_rate"
+            << std::endl;
+
+  for (const std::string &dist : config.dists)
+  {
+    for (int readPercent : config.readPercents)
+    {
+      for (size_t valueSize : config.valueSizes)
+      {
+        const Value value(valueSize, 'v');
+        for (const std::string &policy : config.policies)
+        {
+          // 扩展效率以同一配置下单线程吞吐为基准
+          std::map<int, double> baseline;
+          for (int threadNum : config.threads)
+          {
+            std::unique_ptr<BenchCache> cache = makeCache(policy, config);
+            if (!cache)
+            {
+              std::cerr << "unknown policy: " << policy << std::endl;
+              return 1;
+            }
+
+            std::vector<std::vector<Operation>> threadOps;
+            for (int t = 0; t < threadNum; ++t)
+            {
+              threadOps.push_back(makeOperations(config, dist, readPercent, 1000 + t));
+            }
+
+            // 预热：写满缓存
+            for (size_t k = 0; k < config.capacity; ++k)
+            {
+              cache->put(threadOps[0][k % threadOps[0].size()].key, value);
+            }
+
+            BenchResult result = runOnce(*cache, threadOps, value);
+            double mops = result.totalOps / result.seconds / 1e6;
+            double nsPerOp = result.seconds * 1e9 * threadNum / result.totalOps;
+            if (baseline.empty())
+              baseline[threadNum] = mops / threadNum;
+            double efficiency = mops / (baseline.begin()->second * threadNum);
+            double hitRate = result.gets == 0 ? 0.0 : static_cast<double>(result.hits) / result.gets;
+
+            std::cout << policy << ',' << threadNum << ',' << readPercent << ',' << dist << ','
+                      << valueSize << ',' << result.totalOps << ','
+                      << std::fixed << std::setprecision(4) << result.seconds << ','
+                      << mops << ',' << std::setprecision(1) << nsPerOp << ','
+                      << std::setprecision(3) << efficiency << ',' << hitRate << std::endl;
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
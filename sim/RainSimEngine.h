@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "RainCache.h"
+#include "RainTrace.h"
+
+namespace RainCache
+{
+  // 模拟器使用的统一缓存接口，value 只保存对象大小
+  class SimCache
+  {
+  public:
+    using Key = uint64_t;
+    using Value = uint32_t;
+
+    virtual ~SimCache() = default;
+    virtual void put(Key key, Value value) = 0;
+    virtual bool get(Key key, Value &value) = 0;
+    virtual void remove(Key key) = 0;
+  };
+
+  template <typename Cache>
+  class SimAdapter : public SimCache
+  {
+  public:
+    template <typename... Args>
+    explicit SimAdapter(Args &&...args)
+        : cache_(std::forward<Args>(args)...)
+    {
+    }
+
+    void put(Key key, Value value) override { cache_.put(key, value); }
+
+    // RainCache 派生类经基类接口访问（RainLruK 等会隐藏基类的 get 重载）
+    bool get(Key key, Value &value) override
+    {
+      if constexpr (std::is_base_of_v<RainCache<Key, Value>, Cache>)
+        return static_cast<RainCache<Key, Value> &>(cache_).get(key, value);
+      else
+        return cache_.get(key, value);
+    }
+
+    void remove(Key key) override { cache_.remove(key); }
+
+  private:
+    Cache cache_;
+  };
+
+  // 单个 (策略, 容量) 组合的回放结果
+  struct SimResult
+  {
+    std::string policy;
+    size_t capacity = 0;
+    uint64_t requests = 0;
+    uint64_t gets = 0;
+    uint64_t hits = 0;
+    uint64_t deletes = 0;
+    uint64_t getBytes = 0;
+    uint64_t hitBytes = 0;
+    double seconds = 0; // 该模拟器实际占用工作线程的时间
+
+    double hitRate() const { return gets == 0 ? 0.0 : static_cast<double>(hits) / gets; }
+    double byteHitRate() const { return getBytes == 0 ? 0.0 : static_cast<double>(hitBytes) / getBytes; }
+  };
+
+  // 回放一批访问记录：get 未命中时按需回填，set 直接写入，delete 从缓存中删除
+  inline void replayBatch(SimCache &cache, const std::vector<TraceRecord> &records, SimResult &result)
+  {
+    SimCache::Value value;
+    for (const TraceRecord &record : records)
+    {
+      ++result.requests;
+      switch (record.op)
+      {
+      case TraceOp::Get:
+        ++result.gets;
+        result.getBytes += record.size;
+        if (cache.get(record.key, value))
+        {
+          ++result.hits;
+          result.hitBytes += record.size;
+        }
+        else
+        {
+          cache.put(record.key, record.size);
+        }
+        break;
+      case TraceOp::Set:
+        cache.put(record.key, record.size);
+        break;
+      case TraceOp::Delete:
+        ++result.deletes;
+        cache.remove(record.key);
+        break;
+      }
+    }
+  }
+
+  // 并行模拟引擎：trace 只解码一次，切成批次后分发给所有 (策略, 容量) 模拟器
+  // 每个模拟器同一时刻只由一个工作线程按批次顺序回放，因此缓存内部的锁没有竞争；
+  // 工作线程每次挑选进度最落后且有可用批次的模拟器，最慢的模拟器决定窗口何时前移，
+  // 最多 windowSize 个批次同时驻留内存
+  class SimEngine
+  {
+  public:
+    explicit SimEngine(int threadNum = 0, size_t batchSize = 65536, size_t windowSize = 8)
+        : threadNum_(threadNum > 0 ? threadNum : std::max(1u, std::thread::hardware_concurrency())),
+          batchSize_(std::max<size_t>(batchSize, 1)),
+          windowSize_(std::max<size_t>(windowSize, 1))
+    {
+    }
+
+    // 添加一个模拟器
+    void addSimulator(const std::string &policy, size_t capacity, std::unique_ptr<SimCache> cache)
+    {
+      Simulator sim;
+      sim.cache = std::move(cache);
+      sim.result.policy = policy;
+      sim.result.capacity = capacity;
+      simulators_.push_back(std::move(sim));
+    }
+
+    // 回放 reader 中的全部记录（limit 为 0 时不限条数），返回所有模拟器的结果
+    std::vector<SimResult> run(TraceReader &reader, uint64_t limit = 0)
+    {
+      if (simulators_.empty())
+        return {};
+
+      produced_ = 0;
+      firstBatch_ = 0;
+      finished_ = false;
+      window_.clear();
+      for (Simulator &sim : simulators_)
+      {
+        sim.nextBatch = 0;
+      }
+
+      std::vector<std::thread> workers;
+      int workerNum = std::min<int>(threadNum_, static_cast<int>(simulators_.size()));
+      for (int i = 0; i < workerNum; ++i)
+      {
+        workers.emplace_back([this]()
+                             { workerLoop(); });
+      }
+
+      uint64_t decoded = 0;
+      bool more = true;
+      while (more)
+      {
+        auto batch = std::make_shared<std::vector<TraceRecord>>();
+        batch->reserve(batchSize_);
+        TraceRecord record;
+        while (batch->size() < batchSize_ && (limit == 0 || decoded < limit) && reader.next(record))
+        {
+          batch->push_back(record);
+          ++decoded;
+        }
+        more = batch->size() == batchSize_ && (limit == 0 || decoded < limit);
+        if (batch->empty())
+          break;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        // 窗口已满时等待最慢的模拟器追上来
+        windowCv_.wait(lock, [this]()
+                       { return window_.size() < windowSize_; });
+        window_.push_back(std::move(batch));
+        ++produced_;
+        workCv_.notify_all();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        workCv_.notify_all();
+      }
+      for (auto &worker : workers)
+      {
+        worker.join();
+      }
+
+      std::vector<SimResult> results;
+      for (const Simulator &sim : simulators_)
+      {
+        results.push_back(sim.result);
+      }
+      return results;
+    }
+
+    int threadNum() const { return threadNum_; }
+
+  private:
+    struct Simulator
+    {
+      std::unique_ptr<SimCache> cache;
+      SimResult result;
+      uint64_t nextBatch = 0; // 下一个要回放的批次序号
+      bool busy = false;      // 是否正被某个工作线程回放
+    };
+
+    void workerLoop()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true)
+      {
+        Simulator *sim = nullptr;
+        workCv_.wait(lock, [&]()
+                     { sim = pickSimulator();
+                       return sim != nullptr || allDone(); });
+        if (!sim)
+          return;
+
+        sim->busy = true;
+        std::shared_ptr<const std::vector<TraceRecord>> batch = window_[sim->nextBatch - firstBatch_];
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        replayBatch(*sim->cache, *batch, sim->result);
+        sim->result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        sim->busy = false;
+        ++sim->nextBatch;
+        releaseFinishedBatches();
+        workCv_.notify_all();
+      }
+    }
+
+    // 空闲且有可用批次的模拟器中进度最落后的一个
+    Simulator *pickSimulator()
+    {
+      Simulator *best = nullptr;
+      for (Simulator &sim : simulators_)
+      {
+        if (sim.busy || sim.nextBatch >= produced_)
+          continue;
+        if (!best || sim.nextBatch < best->nextBatch)
+          best = &sim;
+      }
+      return best;
+    }
+
+    bool allDone() const
+    {
+      if (!finished_)
+        return false;
+      for (const Simulator &sim : simulators_)
+      {
+        if (sim.busy || sim.nextBatch < produced_)
+          return false;
+      }
+      return true;
+    }
+
+    // 所有模拟器都回放过的批次移出窗口
+    void releaseFinishedBatches()
+    {
+      uint64_t slowest = produced_;
+      for (const Simulator &sim : simulators_)
+      {
+        slowest = std::min(slowest, sim.nextBatch);
+      }
+      bool released = false;
+      while (firstBatch_ < slowest)
+      {
+        window_.pop_front();
+        ++firstBatch_;
+        released = true;
+      }
+      if (released)
+        windowCv_.notify_one();
+    }
+
+  private:
+    int threadNum_;     // 工作线程数
+    size_t batchSize_;  // 每批记录数
+    size_t windowSize_; // 最多同时驻留的批次数
+
+    std::vector<Simulator> simulators_;
+    std::deque<std::shared_ptr<const std::vector<TraceRecord>>> window_; // 已解码、尚未被所有模拟器回放的批次
+    uint64_t firstBatch_ = 0;                                            // window_ 第一个批次的序号
+    uint64_t produced_ = 0;                                              // 已解码的批次数
+    bool finished_ = false;                                              // trace 是否已读完
+
+    std::mutex mutex_;
+    std::condition_variable workCv_;   // 有新批次或模拟器空闲
+    std::condition_variable windowCv_; // 窗口有空位
+  };
+} // namespace RainCache
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RainCache
+{
+  // 访问类型
+  enum class TraceOp : uint8_t
+  {
+    Get = 0,
+    Set = 1,
+    Delete = 2,
+  };
+
+  // 一条访问记录
+  struct TraceRecord
+  {
+    uint64_t timestamp = 0;
+    uint64_t key = 0;
+    uint32_t size = 1; // 对象大小（字节），用于计算字节命中率
+    TraceOp op = TraceOp::Get;
+  };
+
+  // trace 文件格式
+  enum class TraceFormat
+  {
+    Text,   // 每行一个 key
+    Csv,    // timestamp,key,op,size
+    Binary, // 文件头 + 定长记录
+  };
+
+  // 二进制 trace 格式：8 字节文件头 "RCTRACE1"，随后是小端的 24 字节定长记录
+  struct BinaryTraceRecord
+  {
+    uint64_t timestamp;
+    uint64_t key;
+    uint32_t size;
+    uint8_t op;
+    uint8_t reserved[3];
+  };
+  static_assert(sizeof(BinaryTraceRecord) == 24, "binary trace record must be packed to 24 bytes");
+
+  inline constexpr char kBinaryTraceMagic[8] = {'R', 'C', 'T', 'R', 'A', 'C', 'E', '1'};
+
+  // 基于 mmap 的流式 trace 读取器
+  // 整个文件只映射不拷贝，按顺序读取，每读过一段就通知内核回收对应页面，
+  // 因此常驻内存与 trace 大小无关，可以直接回放数 GB 的生产 trace
+  class TraceReader
+  {
+  public:
+    // 每读过这么多字节释放一次已读页面
+    static constexpr size_t kReleaseChunk = 64 << 20;
+
+    TraceReader() = default;
+    ~TraceReader() { close(); }
+
+    TraceReader(const TraceReader &) = delete;
+    TraceReader &operator=(const TraceReader &) = delete;
+
+    // 打开 trace 文件，失败时返回 false，原因见 error()
+    bool open(const std::string &path, TraceFormat format, uint32_t defaultSize = 1)
+    {
+      close();
+      format_ = format;
+      defaultSize_ = defaultSize;
+
+      fd_ = ::open(path.c_str(), O_RDONLY);
+      if (fd_ < 0)
+        return fail("cannot open " + path + ": " + std::strerror(errno));
+
+      struct stat st;
+      if (::fstat(fd_, &st) != 0)
+        return fail("cannot stat " + path + ": " + std::strerror(errno));
+      size_ = static_cast<size_t>(st.st_size);
+
+      if (size_ > 0)
+      {
+        void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED)
+          return fail("cannot mmap " + path + ": " + std::strerror(errno));
+        data_ = static_cast<const char *>(addr);
+        ::madvise(addr, size_, MADV_SEQUENTIAL);
+      }
+
+      if (format_ == TraceFormat::Binary)
+      {
+        if (size_ < sizeof(kBinaryTraceMagic) ||
+            std::memcmp(data_, kBinaryTraceMagic, sizeof(kBinaryTraceMagic)) != 0)
+          return fail(path + " is not a binary RainCache trace");
+        pos_ = sizeof(kBinaryTraceMagic);
+      }
+      else if (format_ == TraceFormat::Csv)
+      {
+        // 首行不是数字开头时视为表头跳过
+        if (size_ > 0 && (data_[0] < '0' || data_[0] > '9'))
+          nextLine();
+      }
+      released_ = 0;
+      return true;
+    }
+
+    // 读取下一条记录，读到末尾返回 false
+    bool next(TraceRecord &record)
+    {
+      bool ok = false;
+      switch (format_)
+      {
+      case TraceFormat::Binary:
+        ok = nextBinary(record);
+        break;
+      case TraceFormat::Csv:
+        ok = nextCsv(record);
+        break;
+      case TraceFormat::Text:
+        ok = nextText(record);
+        break;
+      }
+      releaseConsumed();
+      return ok;
+    }
+
+    void close()
+    {
+      if (data_)
+        ::munmap(const_cast<char *>(data_), size_);
+      if (fd_ >= 0)
+        ::close(fd_);
+      data_ = nullptr;
+      fd_ = -1;
+      size_ = 0;
+      pos_ = 0;
+      lineNo_ = 0;
+    }
+
+    const std::string &error() const { return error_; }
+    size_t fileSize() const { return size_; }
+    size_t position() const { return pos_; }
+
+    // 按扩展名推断格式：.bin 为二进制，.csv 为 CSV，其余按纯文本处理
+    static TraceFormat guessFormat(const std::string &path)
+    {
+      auto endsWith = [&](std::string_view suffix)
+      {
+        return path.size() >= suffix.size() &&
+               path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+      };
+      if (endsWith(".bin"))
+        return TraceFormat::Binary;
+      if (endsWith(".csv"))
+        return TraceFormat::Csv;
+      return TraceFormat::Text;
+    }
+
+    // 将 key 文本转换为 64 位 key：纯数字直接解析，否则取字符串哈希
+    static uint64_t parseKey(std::string_view text)
+    {
+      uint64_t value = 0;
+      bool numeric = !text.empty() && text.size() <= 19;
+      for (char c : text)
+      {
+        if (c < '0' || c > '9')
+        {
+          numeric = false;
+          break;
+        }
+        value = value * 10 + (c - '0');
+      }
+      return numeric ? value : std::hash<std::string_view>{}(text);
+    }
+
+    // 解析数字前缀，遇到非数字字符停止（如浮点时间戳的小数部分）
+    static uint64_t parseNumber(std::string_view text)
+    {
+      uint64_t value = 0;
+      for (char c : text)
+      {
+        if (c < '0' || c > '9')
+          break;
+        value = value * 10 + (c - '0');
+      }
+      return value;
+    }
+
+    static TraceOp parseOp(std::string_view text)
+    {
+      if (text == "set" || text == "SET" || text == "put" || text == "PUT" || text == "write" || text == "w")
+        return TraceOp::Set;
+      if (text == "delete" || text == "DELETE" || text == "del" || text == "remove")
+        return TraceOp::Delete;
+      return TraceOp::Get;
+    }
+
+  private:
+    bool fail(const std::string &message)
+    {
+      error_ = message;
+      close();
+      return false;
+    }
+
+    // 取出下一行（不含换行符），跳过空行
+    bool nextLine(std::string_view &line)
+    {
+      while (pos_ < size_)
+      {
+        const char *begin = data_ + pos_;
+        const char *end = static_cast<const char *>(std::memchr(begin, '\n', size_ - pos_));
+        size_t length = end ? static_cast<size_t>(end - begin) : size_ - pos_;
+        pos_ += length + (end ? 1 : 0);
+        ++lineNo_;
+
+        if (length > 0 && begin[length - 1] == '\r')
+          --length;
+        if (length > 0)
+        {
+          line = std::string_view(begin, length);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void nextLine()
+    {
+      std::string_view ignored;
+      nextLine(ignored);
+    }
+
+    bool nextText(TraceRecord &record)
+    {
+      std::string_view line;
+      if (!nextLine(line))
+        return false;
+      record.timestamp = lineNo_;
+      record.key = parseKey(line);
+      record.size = defaultSize_;
+      record.op = TraceOp::Get;
+      return true;
+    }
+
+    // timestamp,key,op,size，op 与 size 可以省略
+    bool nextCsv(TraceRecord &record)
+    {
+      std::string_view line;
+      if (!nextLine(line))
+        return false;
+
+      std::string_view fields[4];
+      size_t fieldNum = 0;
+      while (fieldNum < 4)
+      {
+        size_t comma = line.find(',');
+        fields[fieldNum++] = line.substr(0, comma);
+        if (comma == std::string_view::npos)
+          break;
+        line.remove_prefix(comma + 1);
+      }
+
+      record.timestamp = parseNumber(fields[0]);
+      record.key = fieldNum > 1 ? parseKey(fields[1]) : 0;
+      record.op = fieldNum > 2 ? parseOp(fields[2]) : TraceOp::Get;
+      record.size = defaultSize_;
+      if (fieldNum > 3 && !fields[3].empty())
+        record.size = static_cast<uint32_t>(parseNumber(fields[3]));
+      return true;
+    }
+
+    bool nextBinary(TraceRecord &record)
+    {
+      if (size_ - pos_ < sizeof(BinaryTraceRecord))
+        return false;
+
+      BinaryTraceRecord raw;
+      std::memcpy(&raw, data_ + pos_, sizeof(raw));
+      pos_ += sizeof(raw);
+
+      record.timestamp = raw.timestamp;
+      record.key = raw.key;
+      record.size = raw.size;
+      record.op = static_cast<TraceOp>(raw.op);
+      return true;
+    }
+
+    // 已读过的整页交还内核，避免常驻内存随读取进度增长
+    void releaseConsumed()
+    {
+      if (pos_ - released_ < kReleaseChunk)
+        return;
+
+      static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+      size_t end = pos_ / pageSize * pageSize;
+      if (end > released_)
+      {
+        ::madvise(const_cast<char *>(data_) + released_, end - released_, MADV_DONTNEED);
+        released_ = end;
+      }
+    }
+
+  private:
+    int fd_ = -1;
+    const char *data_ = nullptr;
+    size_t size_ = 0;     // 文件大小
+    size_t pos_ = 0;      // 当前读取位置
+    size_t released_ = 0; // 已释放的页面边界
+    uint64_t lineNo_ = 0; // 文本格式的行号
+    uint32_t defaultSize_ = 1;
+    TraceFormat format_ = TraceFormat::Text;
+    std::string error_;
+  };
+
+  // 二进制 trace 写入器，用于把文本/CSV trace 转换为紧凑格式
+  class TraceWriter
+  {
+  public:
+    ~TraceWriter() { close(); }
+
+    bool open(const std::string &path)
+    {
+      file_ = std::fopen(path.c_str(), "wb");
+      if (!file_)
+        return false;
+      return std::fwrite(kBinaryTraceMagic, sizeof(kBinaryTraceMagic), 1, file_) == 1;
+    }
+
+    bool write(const TraceRecord &record)
+    {
+      BinaryTraceRecord raw{};
+      raw.timestamp = record.timestamp;
+      raw.key = record.key;
+      raw.size = record.size;
+      raw.op = static_cast<uint8_t>(record.op);
+      return std::fwrite(&raw, sizeof(raw), 1, file_) == 1;
+    }
+
+    void close()
+    {
+      if (file_)
+        std::fclose(file_);
+      file_ = nullptr;
+    }
+
+  private:
+    std::FILE *file_ = nullptr;
+  };
+} // namespace RainCache
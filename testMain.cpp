@@ -3,13 +3,28 @@
 #include <chrono>
 #include <vector>
 #include <iomanip>
-#include <random>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <functional>
+#include <cstdio>
+#include <malloc.h>
 
 #include "RainCache.h"
 #include "RainLru.h"
 #include "RainLfu.h"
 #include "RainArc.h"
+#include "RainArcAdaptive.h"
+#include "RainCar.h"
+#include "RainFixedLru.h"
+#include "RainFlatLru.h"
+#include "RainSetAssoc.h"
+#include "RainSlab.h"
+#include "RainStaticCache.h"
+#include "RainTiered.h"
+#include "RainWorkload.h"
 
 class Timer
 {
@@ -28,27 +43,14 @@ public:
 
 // 辅助函数：打印结果
 void printResults(const std::string &testName, int capacity,
+                  const std::vector<std::string> &names,
                   const std::vector<int> &get_operations,
-                  const std::vector<int> &hits)
+                  const std::vector<int> &hits,
+                  const std::vector<double> &elapsed)
 {
   std::cout << "=== " << testName << " 结果汇总 ===" << std::endl;
   std::cout << "缓存大小: " << capacity << std::endl;
 
-  // 假设对应的算法名称已在测试函数中定义
-  std::vector<std::string> names;
-  if (hits.size() == 3)
-  {
-    names = {"LRU", "LFU", "ARC"};
-  }
-  else if (hits.size() == 4)
-  {
-    names = {"LRU", "LFU", "ARC", "LRU-K"};
-  }
-  else if (hits.size() == 5)
-  {
-    names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
-  }
-
   for (size_t i = 0; i < hits.size(); ++i)
   {
     double hitRate = 100.0 * hits[i] / get_operations[i];
@@ -56,12 +58,30 @@ void printResults(const std::string &testName, int capacity,
               << " - 命中率: " << std::fixed << std::setprecision(2)
               << hitRate << "% ";
     // 添加具体命中次数和总操作次数
-    std::cout << "(" << hits[i] << "/" << get_operations[i] << ")" << std::endl;
+    std::cout << "(" << hits[i] << "/" << get_operations[i] << ")";
+    // 添加耗时
+    std::cout << " 耗时: " << elapsed[i] << "ms" << std::endl;
   }
 
   std::cout << std::endl; // 添加空行，使输出更清晰
 }
 
+// 辅助函数：打印 ARC 实际驻留的不同 key 数量
+void printArcResidency(const RainCache::RainArc<int, std::string> &arc, int capacity)
+{
+  std::cout << "ARC 驻留不同 key 数: " << arc.size()
+            << " (LRU/LFU 两部分容量各为 " << capacity << ")" << std::endl;
+  std::cout << std::endl;
+}
+
+// 辅助函数：打印缓存内置统计
+void printStats(const std::string &name, const RainCache::CacheStatsSnapshot &stats)
+{
+  std::cout << name << " 内置统计 - 命中: " << stats.hits << " 未命中: " << stats.misses
+            << " 写入: " << stats.puts << " 淘汰: " << stats.evictions
+            << " 幽灵命中: " << stats.ghostHits << " 老化: " << stats.agingEvents << std::endl;
+}
+
 void testHotDataAccess()
 {
   std::cout << "\n=== 测试场景1：热点数据访问测试 ===" << std::endl;
@@ -80,19 +100,29 @@ void testHotDataAccess()
   // - k = 2 表示数据被访问 2 次后才会进入缓存，适合区分热点和冷数据
   RainCache::RainLruK<int, std::string> lruk(CAPACITY, HOT_KEYS + COLD_KEYS, 2);
   RainCache::RainLfu<int, std::string> lfuAging(CAPACITY, 20000);
+  RainCache::RainArcAdaptive<int, std::string> arcAdaptive(CAPACITY);
+  RainCache::RainCar<int, std::string> car(CAPACITY);
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
+  // 70%概率访问热点数据，30%概率访问冷数据；大多数缓存系统中读操作比写操作频繁，所以设置30%概率进行写操作
+  // 固定种子预先生成一次操作序列，所有缓存回放同一序列
+  RainCache::Workload workload;
+  auto keys = std::make_unique<RainCache::MixedKeys>();
+  keys->add(70, std::make_unique<RainCache::UniformKeys>(0, HOT_KEYS));         // 热点数据
+  keys->add(30, std::make_unique<RainCache::UniformKeys>(HOT_KEYS, COLD_KEYS)); // 冷数据
+  workload.addPhase(OPERATIONS, 30, std::move(keys));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
 
   // 基类指针指向派生类对象，添加LFU-Aging
-  std::array<RainCache::RainCache<int, std::string> *, 5> caches = {&lru, &lfu, &arc, &lruk, &lfuAging};
-  std::vector<int> hits(5, 0);
-  std::vector<int> get_operations(5, 0);
-  std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
+  std::array<RainCache::RainCache<int, std::string> *, 7> caches = {&lru, &lfu, &arc, &lruk, &lfuAging, &arcAdaptive, &car};
+  std::vector<int> hits(7, 0);
+  std::vector<int> get_operations(7, 0);
+  std::vector<double> elapsed(7, 0);
+  std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging", "ARC-Adaptive", "CAR"};
 
   // 为所有的缓存对象进行相同的操作序列测试
   for (int i = 0; i < caches.size(); ++i)
   {
+    Timer timer;
     // 先预热缓存，插入一些热点数据
     for (int key = 0; key < HOT_KEYS; ++key)
     {
@@ -103,23 +133,8 @@ void testHotDataAccess()
     // 交替进行 put 和 get 操作，模拟真实场景
     for (int op = 0; op < OPERATIONS; ++op)
     {
-      // 大多数缓存系统中读操作比写操作频繁
-      // 所以设置30%概率进行写操作
-      bool isPut = (gen() % 100 < 30);
-      bool isHot = (gen() % 100 < 70);
-      int key;
-
-      // 70%概率访问热点数据，30%概率访问冷数据
-      if (isHot)
-      {
-        key = gen() % HOT_KEYS; // 热点数据
-      }
-      else
-      {
-        key = HOT_KEYS + (gen() % COLD_KEYS); // 冷数据
-      }
-
-      if (isPut)
+      int key = static_cast<int>(ops[op].key);
+      if (ops[op].isPut)
       {
         // 执行put操作
         std::string value = "value" + std::to_string(key) + "_v" + std::to_string(op % 100);
@@ -136,10 +151,18 @@ void testHotDataAccess()
         }
       }
     }
+    elapsed[i] = timer.elapsed();
   }
 
   // 打印测试结果
-  printResults("热点数据访问测试", CAPACITY, get_operations, hits);
+  printResults("热点数据访问测试", CAPACITY, names, get_operations, hits, elapsed);
+  printArcResidency(arc, CAPACITY);
+  printStats("LRU", lru.stats());
+  printStats("LFU", lfu.stats());
+  printStats("ARC", arc.stats());
+  printStats("LFU-Aging", lfuAging.stats());
+  printStats("CAR", car.stats());
+  std::cout << std::endl;
 }
 
 void testLoopPattern()
@@ -159,18 +182,28 @@ void testLoopPattern()
   RainCache::RainLruK<int, std::string> lruk(CAPACITY, LOOP_SIZE * 2, 2);
   // 平均频率最大值 - 3000
   RainCache::RainLfu<int, std::string> lfuAging(CAPACITY, 3000);
+  RainCache::RainArcAdaptive<int, std::string> arcAdaptive(CAPACITY);
+  RainCache::RainCar<int, std::string> car(CAPACITY);
 
-  std::array<RainCache::RainCache<int, std::string> *, 5> caches = {&lru, &lfu, &arc, &lruk, &lfuAging};
-  std::vector<int> hits(5, 0);
-  std::vector<int> get_operations(5, 0);
-  std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
+  std::array<RainCache::RainCache<int, std::string> *, 7> caches = {&lru, &lfu, &arc, &lruk, &lfuAging, &arcAdaptive, &car};
+  std::vector<int> hits(7, 0);
+  std::vector<int> get_operations(7, 0);
+  std::vector<double> elapsed(7, 0);
+  std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging", "ARC-Adaptive", "CAR"};
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
+  // 60%顺序扫描，30%随机跳跃，10%访问范围外数据；20%概率是写操作，80%概率是读操作
+  RainCache::Workload workload;
+  auto keys = std::make_unique<RainCache::MixedKeys>();
+  keys->add(60, std::make_unique<RainCache::ScanKeys>(0, LOOP_SIZE));
+  keys->add(30, std::make_unique<RainCache::UniformKeys>(0, LOOP_SIZE));
+  keys->add(10, std::make_unique<RainCache::UniformKeys>(LOOP_SIZE, LOOP_SIZE));
+  workload.addPhase(OPERATIONS, 20, std::move(keys));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
 
   // 为每种缓存算法运行相同的测试
   for (int i = 0; i < caches.size(); ++i)
   {
+    Timer timer;
     // 先预热一部分数据（只加载 20% / 1/5 的数据）
     for (int key = 0; key < LOOP_SIZE / 5; ++key)
     {
@@ -178,35 +211,11 @@ void testLoopPattern()
       caches[i]->put(key, value);
     }
 
-    // 设置循环扫描的当前位置
-    int current_pos = 0;
-
     // 交替进行读写操作，模拟真实场景
     for (int op = 0; op < OPERATIONS; ++op)
     {
-      // 20%概率是写操作，80%概率是读操作
-      bool isPut = (gen() % 100 < 20);
-      int key;
-
-      // 按照不同模式选择键
-      if (op % 100 < 60)
-      // 60%顺序扫描
-      {
-        key = current_pos;
-        current_pos = (current_pos + 1) % LOOP_SIZE;
-      }
-      else if (op % 100 < 90)
-      // 30%随机跳跃
-      {
-        key = gen() % LOOP_SIZE;
-      }
-      else
-      // 10%访问范围外数据
-      {
-        key = LOOP_SIZE + (gen() % LOOP_SIZE);
-      }
-
-      if (isPut)
+      int key = static_cast<int>(ops[op].key);
+      if (ops[op].isPut)
       // 存数据
       {
         // 执行put操作，更新数据
@@ -225,9 +234,11 @@ void testLoopPattern()
         }
       }
     }
+    elapsed[i] = timer.elapsed();
   }
 
-  printResults("循环扫描测试", CAPACITY, get_operations, hits);
+  printResults("循环扫描测试", CAPACITY, names, get_operations, hits, elapsed);
+  printArcResidency(arc, CAPACITY);
 }
 
 void testWorkloadShift()
@@ -243,17 +254,37 @@ void testWorkloadShift()
   RainCache::RainArc<int, std::string> arc(CAPACITY);
   RainCache::RainLruK<int, std::string> lruk(CAPACITY, 500, 2);
   RainCache::RainLfu<int, std::string> lfuAging(CAPACITY, 10000);
+  RainCache::RainArcAdaptive<int, std::string> arcAdaptive(CAPACITY);
+  RainCache::RainCar<int, std::string> car(CAPACITY);
+
+  std::array<RainCache::RainCache<int, std::string> *, 7> caches = {&lru, &lfu, &arc, &lruk, &lfuAging, &arcAdaptive, &car};
+  std::vector<int> hits(7, 0);
+  std::vector<int> get_operations(7, 0);
+  std::vector<double> elapsed(7, 0);
+  std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging", "ARC-Adaptive", "CAR"};
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::array<RainCache::RainCache<int, std::string> *, 5> caches = {&lru, &lfu, &arc, &lruk, &lfuAging};
-  std::vector<int> hits(5, 0);
-  std::vector<int> get_operations(5, 0);
-  std::vector<std::string> names = {"LRU", "LFU", "ARC", "LRU-K", "LFU-Aging"};
+  // 进行多阶段测试，每个阶段有不同的访问模式和读写比例
+  RainCache::Workload workload;
+  // 阶段1: 热点访问 - 热点数量5，15%写入
+  workload.addPhase(PHASE_LENGTH, 15, std::make_unique<RainCache::UniformKeys>(0, 5));
+  // 阶段2: 大范围随机 - 范围400，写比例为30%
+  workload.addPhase(PHASE_LENGTH, 30, std::make_unique<RainCache::UniformKeys>(0, 400));
+  // 阶段3: 顺序扫描 - 100个键，10%写入
+  workload.addPhase(PHASE_LENGTH, 10, std::make_unique<RainCache::ScanKeys>(0, 100));
+  // 阶段4: 局部性随机 - 5个局部区域，每个区域15个键，每800次操作切换一次，25%写入
+  workload.addPhase(PHASE_LENGTH, 25, std::make_unique<RainCache::ShiftingHotSetKeys>(0, 15, 800, 15, 5));
+  // 阶段5: 混合访问 - 40%热点，30%中等范围，30%大范围，20%写入
+  auto mixed = std::make_unique<RainCache::MixedKeys>();
+  mixed->add(40, std::make_unique<RainCache::UniformKeys>(0, 5));
+  mixed->add(30, std::make_unique<RainCache::UniformKeys>(5, 45));
+  mixed->add(30, std::make_unique<RainCache::UniformKeys>(50, 350));
+  workload.addPhase(PHASE_LENGTH, 20, std::move(mixed));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
 
   // 为每种缓存算法运行相同的测试
   for (int i = 0; i < caches.size(); ++i)
   {
+    Timer timer;
     // 先预热缓存，只插入少量初始数据
     for (int key = 0; key < 30; ++key)
     {
@@ -261,95 +292,1008 @@ void testWorkloadShift()
       caches[i]->put(key, value);
     }
 
-    // 进行多阶段测试，每个阶段有不同的访问模式
     for (int op = 0; op < OPERATIONS; ++op)
     {
-      // 确定当前阶段
-      int phase = op / PHASE_LENGTH;
+      int key = static_cast<int>(ops[op].key);
+      if (ops[op].isPut)
+      {
+        // 执行写操作
+        std::string value = "value" + std::to_string(key) + "_p" + std::to_string(ops[op].phase);
+        caches[i]->put(key, value);
+      }
+      else
+      {
+        // 执行读操作并记录命中情况
+        std::string result;
+        get_operations[i]++;
+        if (caches[i]->get(key, result))
+        {
+          hits[i]++;
+        }
+      }
+    }
+    elapsed[i] = timer.elapsed();
+  }
+
+  printResults("工作负载剧烈变化测试", CAPACITY, names, get_operations, hits, elapsed);
+  printArcResidency(arc, CAPACITY);
+}
 
-      // 每个阶段的读写比例不同
-      int putProbability;
-      switch (phase)
+// 多线程吞吐测试：所有线程同时开始，持续 duration 后一起停止，返回总吞吐（Mops/s）
+// 按固定时长而不是固定操作数运行，线程数与缓存实现不同时测量窗口都足够长；计时用纳秒精度的 steady_clock
+double runConcurrent(int threadNum, std::chrono::milliseconds duration, int keyRange,
+                     const std::function<void(int, int)> &putFunc,
+                     const std::function<bool(int)> &getFunc)
+{
+  std::vector<std::thread> threads;
+  std::atomic<bool> started{false};
+  std::atomic<bool> stopped{false};
+  std::atomic<long long> totalOps{0};
+  for (int t = 0; t < threadNum; ++t)
+  {
+    threads.emplace_back([&, t]()
+                         {
+      RainCache::WorkloadRng rng(RainCache::kDefaultWorkloadSeed + t);
+      while (!started.load(std::memory_order_acquire))
       {
-      case 0:
-        putProbability = 15;
-        break; // 阶段1: 热点访问，15%写入更合理
-      case 1:
-        putProbability = 30;
-        break; // 阶段2: 大范围随机，写比例为30%
-      case 2:
-        putProbability = 10;
-        break; // 阶段3: 顺序扫描，10%写入保持不变
-      case 3:
-        putProbability = 25;
-        break; // 阶段4: 局部性随机，微调为25%
-      case 4:
-        putProbability = 20;
-        break; // 阶段5: 混合访问，调整为20%
-      default:
-        putProbability = 20;
+        std::this_thread::yield();
       }
+      long long ops = 0;
+      // 每 256 次操作检查一次停止标志
+      while (!stopped.load(std::memory_order_relaxed))
+      {
+        for (int i = 0; i < 256; ++i, ++ops)
+        {
+          int key = static_cast<int>(rng.uniform(keyRange));
+          // 20%写，80%读
+          if (rng.chance(20))
+            putFunc(key, static_cast<int>(ops));
+          else
+            getFunc(key);
+        }
+      }
+      totalOps.fetch_add(ops, std::memory_order_relaxed); });
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  started.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(duration);
+  stopped.store(true, std::memory_order_relaxed);
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+  return totalOps.load() / us;
+}
+
+void testShardScaling()
+{
+  std::cout << "\n=== 测试场景4：分片缓存多线程扩展性测试 ===" << std::endl;
+
+  const int CAPACITY = 4096;     // 缓存总容量
+  const int SLICE_NUM = 16;      // 分片数量
+  const int KEY_RANGE = 16384;   // key 范围
+  const std::chrono::milliseconds RUN_TIME(200); // 每个缓存、每组线程数的运行时长
+
+  // 更细的扫描（读写比例、key 分布、value 大小）见 raincache_bench --policies lru-hash,lfu-hash,arc-hash,set-assoc
+  std::cout << "每组运行 " << RUN_TIME.count() << " ms" << std::endl;
+  std::cout << std::left << "线程数  "
+            << std::setw(14) << "LRU-Hash" << std::setw(14) << "LFU-Hash" << std::setw(14) << "ARC-Hash"
+            << std::setw(14) << "SetAssoc" << "(Mops/s)" << std::endl;
+
+  for (int threadNum = 1; threadNum <= 64; threadNum *= 2)
+  {
+    RainCache::RainLruHash<int, int> lruHash(CAPACITY, SLICE_NUM);
+    RainCache::RainLfuHash<int, int> lfuHash(CAPACITY, SLICE_NUM);
+    RainCache::RainArcHash<int, int> arcHash(CAPACITY, SLICE_NUM);
+    RainCache::RainSetAssoc<int, int> setAssoc(CAPACITY);
+
+    double lruOps = runConcurrent(
+        threadNum, RUN_TIME, KEY_RANGE,
+        [&](int key, int value)
+        { lruHash.put(key, value); },
+        [&](int key)
+        { int value; return lruHash.get(key, value); });
+    double lfuOps = runConcurrent(
+        threadNum, RUN_TIME, KEY_RANGE,
+        [&](int key, int value)
+        { lfuHash.put(key, value); },
+        [&](int key)
+        { int value; return lfuHash.get(key, value); });
+    double arcOps = runConcurrent(
+        threadNum, RUN_TIME, KEY_RANGE,
+        [&](int key, int value)
+        { arcHash.put(key, value); },
+        [&](int key)
+        { int value; return arcHash.get(key, value); });
+    double setAssocOps = runConcurrent(
+        threadNum, RUN_TIME, KEY_RANGE,
+        [&](int key, int value)
+        { setAssoc.put(key, value); },
+        [&](int key)
+        { int value; return setAssoc.get(key, value); });
+
+    std::cout << std::left << std::fixed << std::setprecision(2)
+              << std::setw(8) << threadNum
+              << std::setw(14) << lruOps << std::setw(14) << lfuOps << std::setw(14) << arcOps
+              << std::setw(14) << setAssocOps
+              << std::endl;
+  }
+  std::cout << std::right << std::endl;
+}
+
+// 辅助函数：打印一组延迟分位数
+void printLatency(const std::string &name, const RainCache::LatencySnapshot &latency)
+{
+  std::cout << std::left << std::setw(12) << name << std::right
+            << " 样本: " << std::setw(8) << latency.count
+            << " p50: " << std::setw(7) << latency.percentile(0.50) << "ns"
+            << " p99: " << std::setw(7) << latency.percentile(0.99) << "ns"
+            << " p999: " << std::setw(8) << latency.percentile(0.999) << "ns"
+            << " max: " << latency.max << "ns" << std::endl;
+}
+
+// 分片延迟直方图：多线程压测后打印各操作延迟，并找出 p99 最高的分片
+template <typename Cache>
+void runShardLatency(const std::string &name, Cache &cache, int sliceNum)
+{
+  const int THREAD_NUM = 8;                      // 线程数
+  const int KEY_RANGE = 16384;                   // key 范围
+  const std::chrono::milliseconds RUN_TIME(200); // 运行时长
+
+  cache.enableLatencyTracking();
+  runConcurrent(
+      THREAD_NUM, RUN_TIME, KEY_RANGE,
+      [&](int key, int value)
+      { cache.put(key, value); },
+      [&](int key)
+      { int value; return cache.get(key, value); });
 
-      // 确定是读还是写操作
-      bool isPut = (gen() % 100 < putProbability);
+  RainCache::ShardLatencySnapshot total = cache.latencySnapshot();
+  std::cout << "--- " << name << " (" << THREAD_NUM << " 线程) ---" << std::endl;
+  printLatency("get", total.get);
+  printLatency("put", total.put);
+  printLatency("eviction", total.eviction);
+  printLatency("aging", total.aging);
+  printLatency("lock wait", total.lockWait);
+  printLatency("lock hold", total.lockHold);
 
-      // 根据不同阶段选择不同的访问模式生成key - 优化后的访问范围
-      int key;
-      if (op < PHASE_LENGTH)
-      { // 阶段1: 热点访问 - 热点数量5，使热点更集中
-        key = gen() % 5;
+  int worstSlice = 0;
+  uint64_t worstP99 = 0;
+  for (int i = 0; i < sliceNum; ++i)
+  {
+    uint64_t p99 = cache.latencySnapshot(i).get.percentile(0.99);
+    if (p99 > worstP99)
+    {
+      worstP99 = p99;
+      worstSlice = i;
+    }
+  }
+  std::cout << "get p99 最高的分片: " << worstSlice << " (" << worstP99 << "ns)" << std::endl;
+}
+
+void testShardLatency()
+{
+  std::cout << "\n=== 测试场景6：分片延迟直方图 ===" << std::endl;
+
+  const int CAPACITY = 4096; // 缓存总容量
+  const int SLICE_NUM = 16;  // 分片数量
+
+  RainCache::RainLruHash<int, int> lruHash(CAPACITY, SLICE_NUM);
+  RainCache::RainLfuHash<int, int> lfuHash(CAPACITY, SLICE_NUM);
+  runShardLatency("LRU-Hash", lruHash, SLICE_NUM);
+  runShardLatency("LFU-Hash", lfuHash, SLICE_NUM);
+  std::cout << std::endl;
+}
+
+// 测试场景5 的访问序列，key 落在 [0, HOT_KEYS + COLD_KEYS) 内
+constexpr int HOT_KEYS = 64;    // 热点数据数量
+constexpr int COLD_KEYS = 5000; // 冷数据数量
+
+// 同一份热点访问序列在单线程下跑一遍，打印命中率与吞吐
+template <typename Cache>
+void runSingleThreadWorkload(const std::string &name, Cache &cache)
+{
+  const int OPERATIONS = 300000; // 总操作次数
+
+  RainCache::WorkloadRng rng;
+  int hits = 0;
+  int gets = 0;
+  Timer timer;
+  for (int op = 0; op < OPERATIONS; ++op)
+  {
+    int key = static_cast<int>(rng.chance(70) ? rng.uniform(HOT_KEYS) : HOT_KEYS + rng.uniform(COLD_KEYS));
+    if (rng.chance(30))
+    {
+      cache.put(key, op);
+    }
+    else
+    {
+      int value;
+      ++gets;
+      if (cache.get(key, value))
+        ++hits;
+    }
+  }
+  double ms = std::max(timer.elapsed(), 1.0);
+  std::cout << std::left << std::setw(28) << name << std::right
+            << " - 命中率: " << std::fixed << std::setprecision(2) << 100.0 * hits / gets << "% "
+            << " 吞吐: " << OPERATIONS / ms / 1000.0 << " Mops/s" << std::endl;
+}
+
+void testStaticComposition()
+{
+  std::cout << "\n=== 测试场景5：编译期组合缓存与虚函数缓存对比 ===" << std::endl;
+
+  const int CAPACITY = 64; // 缓存容量
+
+  RainCache::RainLru<int, int> lru(CAPACITY);
+  RainCache::RainLfu<int, int> lfu(CAPACITY);
+  RainCache::RainArcAdaptive<int, int> arc(CAPACITY);
+  RainCache::RainCache<int, int> *lruBase = &lru;
+  RainCache::RainCache<int, int> *lfuBase = &lfu;
+  RainCache::RainCache<int, int> *arcBase = &arc;
+
+  RainCache::RainStaticCache<int, int, RainCache::StaticLru, RainCache::NullLock> lruNull(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticLru, RainCache::SpinLock> lruSpin(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticLru, std::mutex> lruMutex(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticLru, std::shared_mutex> lruShared(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticLfu, RainCache::NullLock> lfuNull(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticArc, RainCache::NullLock> arcNull(CAPACITY);
+
+  // key 有上界，可以用数组直接索引
+  using Dense = RainCache::DenseIndex<8192>;
+  static_assert(HOT_KEYS + COLD_KEYS <= 8192, "DenseIndex 的上界需覆盖全部 key");
+  RainCache::RainStaticCache<int, int, RainCache::StaticLru, RainCache::NullLock, std::allocator<int>, Dense> lruDense(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticLfu, RainCache::NullLock, std::allocator<int>, Dense> lfuDense(CAPACITY);
+  RainCache::RainStaticCache<int, int, RainCache::StaticArc, RainCache::NullLock, std::allocator<int>, Dense> arcDense(CAPACITY);
+
+  runSingleThreadWorkload("LRU (virtual)", *lruBase);
+  runSingleThreadWorkload("Static LRU + NullLock", lruNull);
+  runSingleThreadWorkload("Static LRU + SpinLock", lruSpin);
+  runSingleThreadWorkload("Static LRU + mutex", lruMutex);
+  runSingleThreadWorkload("Static LRU + shared_mutex", lruShared);
+  runSingleThreadWorkload("Static LRU + DenseIndex", lruDense);
+  runSingleThreadWorkload("LFU (virtual)", *lfuBase);
+  runSingleThreadWorkload("Static LFU + NullLock", lfuNull);
+  runSingleThreadWorkload("Static LFU + DenseIndex", lfuDense);
+  runSingleThreadWorkload("ARC-Adaptive (virtual)", *arcBase);
+  runSingleThreadWorkload("Static ARC + NullLock", arcNull);
+  runSingleThreadWorkload("Static ARC + DenseIndex", arcDense);
+  std::cout << std::endl;
+}
+
+// 用同一段访问序列预热 warm 后保存快照，载入 restored，再与从零开始的 cold 一起回放后续访问
+template <typename Cache>
+void runSnapshotRestart(const std::string &name, Cache &warm, Cache &restored, Cache &cold,
+                        const std::vector<RainCache::WorkloadOp> &ops)
+{
+  const std::string path = "raincache_snapshot_test.bin";
+  size_t half = ops.size() / 2;
+  for (size_t i = 0; i < half; ++i)
+  {
+    int key = static_cast<int>(ops[i].key);
+    std::string value;
+    if (!static_cast<RainCache::RainCache<int, std::string> &>(warm).get(key, value))
+      warm.put(key, "value" + std::to_string(key));
+  }
+
+  Timer timer;
+  bool ok = warm.saveSnapshot(path) && restored.loadSnapshot(path);
+  double ms = timer.elapsed();
+  std::remove(path.c_str());
+  if (!ok)
+  {
+    std::cout << name << " - 快照保存/加载失败" << std::endl;
+    return;
+  }
+
+  // 未命中时回填，比较重启后前半段的命中率
+  std::array<Cache *, 2> caches = {&restored, &cold};
+  std::array<int, 2> hits = {0, 0};
+  for (size_t c = 0; c < caches.size(); ++c)
+  {
+    RainCache::RainCache<int, std::string> &cache = *caches[c];
+    for (size_t i = half; i < ops.size(); ++i)
+    {
+      int key = static_cast<int>(ops[i].key);
+      std::string value;
+      if (cache.get(key, value))
+        ++hits[c];
+      else
+        cache.put(key, "value" + std::to_string(key));
+    }
+  }
+
+  int gets = static_cast<int>(ops.size() - half);
+  std::cout << std::left << std::setw(14) << name << std::right
+            << " - 快照往返: " << ms << " ms"
+            << "  热重启命中率: " << std::fixed << std::setprecision(2) << 100.0 * hits[0] / gets << "%"
+            << "  冷启动命中率: " << 100.0 * hits[1] / gets << "%" << std::endl;
+}
+
+void testSnapshotRestart()
+{
+  std::cout << "\n=== 测试场景7：快照保存与热重启 ===" << std::endl;
+
+  const int CAPACITY = 2000;     // 缓存容量
+  const int KEYS = 20000;        // key 范围
+  const int OPERATIONS = 100000; // 总操作次数，前一半用于预热
+
+  RainCache::Workload workload;
+  workload.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
+
+  {
+    RainCache::RainLru<int, std::string> warm(CAPACITY), restored(CAPACITY), cold(CAPACITY);
+    runSnapshotRestart("LRU", warm, restored, cold, ops);
+  }
+  {
+    RainCache::RainLfu<int, std::string> warm(CAPACITY), restored(CAPACITY), cold(CAPACITY);
+    runSnapshotRestart("LFU", warm, restored, cold, ops);
+  }
+  {
+    RainCache::RainArc<int, std::string> warm(CAPACITY), restored(CAPACITY), cold(CAPACITY);
+    runSnapshotRestart("ARC", warm, restored, cold, ops);
+  }
+  {
+    RainCache::RainArcAdaptive<int, std::string> warm(CAPACITY), restored(CAPACITY), cold(CAPACITY);
+    runSnapshotRestart("ARC-Adaptive", warm, restored, cold, ops);
+  }
+  {
+    RainCache::RainCar<int, std::string> warm(CAPACITY), restored(CAPACITY), cold(CAPACITY);
+    runSnapshotRestart("CAR", warm, restored, cold, ops);
+  }
+
+  // 分片缓存：每个分片一个段，加载时并行校验与重建
+  const int SHARD_CAPACITY = 1000000; // 分片缓存总容量
+  const int SLICES = 16;              // 分片数
+  const std::string path = "raincache_sharded_snapshot_test.bin";
+  RainCache::RainLruHash<int, int> sharded(SHARD_CAPACITY, SLICES);
+  for (int key = 0; key < SHARD_CAPACITY; ++key)
+  {
+    sharded.put(key, key);
+  }
+  sharded.saveSnapshot(path);
+  for (int threads : {1, 0})
+  {
+    RainCache::RainLruHash<int, int> restored(SHARD_CAPACITY, SLICES);
+    Timer timer;
+    bool ok = restored.loadSnapshot(path, threads);
+    int value = -1;
+    std::cout << "LRU-Hash 加载 " << SHARD_CAPACITY << " 条 (" << (threads == 0 ? "全部核心" : "单线程") << "): "
+              << timer.elapsed() << " ms" << (ok && restored.get(SHARD_CAPACITY / 2, value) && value == SHARD_CAPACITY / 2 ? "" : " 失败")
+              << std::endl;
+  }
+  std::remove(path.c_str());
+}
+
+// 工作集远大于内存层时，对比只有内存层与加上磁盘层后的回源次数
+void testTieredCache()
+{
+  std::cout << "\n=== 测试场景8：内存 + 磁盘两级缓存 ===" << std::endl;
+
+  const int MEMORY_CAPACITY = 2000;     // 内存层容量
+  const int KEYS = 50000;               // key 范围，约为内存层的 25 倍
+  const int OPERATIONS = 300000;        // 总操作次数
+  const uint64_t DISK_BYTES = 16 << 20; // 磁盘层日志大小
+  const int BATCH = 64;                 // 批量读取的大小
+  const std::string path = "raincache_tiered_test.log";
+
+  RainCache::Workload workload;
+  workload.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.8));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
+
+  // 未命中视为一次回源，随后写入缓存
+  RainCache::RainLru<int, std::string> memoryOnly(MEMORY_CAPACITY);
+  int memoryOnlyFetches = 0;
+  for (const RainCache::WorkloadOp &op : ops)
+  {
+    int key = static_cast<int>(op.key);
+    std::string value;
+    if (!memoryOnly.get(key, value))
+    {
+      ++memoryOnlyFetches;
+      memoryOnly.put(key, "value" + std::to_string(key));
+    }
+  }
+
+  RainCache::RainTiered<int, std::string> tiered(
+      std::make_unique<RainCache::RainLru<int, std::string>>(MEMORY_CAPACITY), path, DISK_BYTES);
+  int tieredFetches = 0;
+  Timer timer;
+  std::vector<int> keys;
+  std::vector<std::string> values;
+  std::vector<bool> found;
+  for (size_t begin = 0; begin < ops.size(); begin += BATCH)
+  {
+    keys.clear();
+    for (size_t i = begin; i < std::min(ops.size(), begin + BATCH); ++i)
+    {
+      keys.push_back(static_cast<int>(ops[i].key));
+    }
+    tiered.getBatch(keys, values, found);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      if (!found[i])
+      {
+        ++tieredFetches;
+        tiered.put(keys[i], "value" + std::to_string(keys[i]));
       }
-      else if (op < PHASE_LENGTH * 2)
-      { // 阶段2: 大范围随机 - 范围400，更适合30大小的缓存
-        key = gen() % 400;
+    }
+  }
+  double ms = timer.elapsed();
+  std::remove(path.c_str());
+
+  RainCache::TieredStatsSnapshot stats = tiered.stats();
+  std::cout << "只有内存层 - 回源次数: " << memoryOnlyFetches << std::endl;
+  std::cout << "内存 + 磁盘 - 回源次数: " << tieredFetches << "  内存命中: " << stats.memoryHits
+            << "  磁盘命中: " << stats.diskHits << "  磁盘写入: " << stats.diskWrites
+            << "  读盘方式: " << (tiered.usingUring() ? "io_uring" : "pread 线程池")
+            << "  耗时: " << ms << " ms" << std::endl;
+}
+
+// 相同负载下对比 slab 字节缓存与 RainLru<std::string, std::string> 的每条目内存占用
+void testSlabMemory()
+{
+  std::cout << "\n=== 测试场景9：slab 字节缓存内存占用 ===" << std::endl;
+
+  const size_t MEMORY_LIMIT = 32 << 20; // slab 缓存的内存上限
+  const int KEYS = 200000;              // key 范围
+  const int OPERATIONS = 500000;        // 总操作次数
+
+  RainCache::Workload workload(RainCache::kDefaultWorkloadSeed, RainCache::ValueSizeDistribution::bimodal(100, 2000, 10));
+  workload.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
+
+  RainCache::RainSlabLru slab(MEMORY_LIMIT);
+  std::string value;
+  for (const RainCache::WorkloadOp &op : ops)
+  {
+    std::string key = "key:" + std::to_string(op.key);
+    if (!slab.getBytes(key, value))
+      slab.setBytes(key, std::string(op.valueSize, 'v'));
+  }
+  RainCache::SlabMemoryStats memory = slab.memoryStats();
+
+  // 容量取 slab 缓存最终的条目数，用堆上实际占用的字节数衡量
+  size_t heapBefore = mallinfo2().uordblks;
+  size_t lruHeapBytes = 0;
+  {
+    RainCache::RainLru<std::string, std::string> lru(static_cast<int>(memory.items));
+    for (const RainCache::WorkloadOp &op : ops)
+    {
+      std::string key = "key:" + std::to_string(op.key);
+      if (!lru.get(key, value))
+        lru.put(key, std::string(op.valueSize, 'v'));
+    }
+    size_t heapBytes = mallinfo2().uordblks - heapBefore;
+    std::cout << "RainLru<string>  条目: " << memory.items << "  堆占用: " << (heapBytes >> 20) << " MB"
+              << "  命中率: " << std::fixed << std::setprecision(2) << 100.0 * lru.stats().hitRate() << "%" << std::endl;
+    lruHeapBytes = heapBytes;
+  }
+  std::cout << "RainSlabLru      条目: " << memory.items << "  页+索引: "
+            << ((memory.pageBytes + memory.indexBytes) >> 20) << " MB"
+            << "  命中率: " << 100.0 * slab.stats().hitRate() << "%"
+            << "  每条目额外开销: " << memory.overheadPerItem() << " B"
+            << "  (RainLru: " << (static_cast<double>(lruHeapBytes) - memory.payloadBytes) / memory.items << " B)"
+            << std::endl;
+}
+
+// value 大小分布突变：先写满小对象，再切换到大对象，对比开启与关闭页重平衡时第二阶段的命中率，
+// 然后删掉一部分条目，看碎片整理能腾出多少页
+void testSlabRebalance()
+{
+  std::cout << "\n=== 测试场景10：slab 页重平衡与碎片整理 ===" << std::endl;
+
+  const size_t MEMORY_LIMIT = 32 << 20; // slab 缓存的内存上限
+  const int SLICES = 4;                 // 分片数
+  const int KEYS = 100000;              // 每个阶段的 key 范围
+  const int OPERATIONS = 400000;        // 每个阶段的操作次数
+  const int MAINTAIN_EVERY = 5000;      // 每隔多少次操作做一次维护
+
+  RainCache::Workload small(RainCache::kDefaultWorkloadSeed, RainCache::ValueSizeDistribution::uniform(60, 120));
+  small.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9));
+  RainCache::Workload large(RainCache::kDefaultWorkloadSeed + 1, RainCache::ValueSizeDistribution::uniform(1200, 1800));
+  large.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9, KEYS));
+  const std::vector<RainCache::WorkloadOp> smallOps = small.generate(OPERATIONS);
+  const std::vector<RainCache::WorkloadOp> largeOps = large.generate(OPERATIONS);
+
+  for (bool rebalance : {false, true})
+  {
+    RainCache::RainSlabLruHash slab(MEMORY_LIMIT, SLICES);
+    std::string value;
+    auto replay = [&](const std::vector<RainCache::WorkloadOp> &ops)
+    {
+      for (size_t i = 0; i < ops.size(); ++i)
+      {
+        std::string key = "key:" + std::to_string(ops[i].key);
+        if (!slab.getBytes(key, value))
+          slab.setBytes(key, std::string(ops[i].valueSize, 'v'));
+        if (rebalance && i % MAINTAIN_EVERY == 0)
+          slab.maintain();
       }
-      else if (op < PHASE_LENGTH * 3)
-      { // 阶段3: 顺序扫描 - 保持100个键
-        key = (op - PHASE_LENGTH * 2) % 100;
+    };
+
+    replay(smallOps);
+    RainCache::CacheStatsSnapshot before = slab.stats();
+    replay(largeOps);
+    RainCache::CacheStatsSnapshot after = slab.stats();
+    uint64_t hits = after.hits - before.hits;
+    uint64_t misses = after.misses - before.misses;
+    std::cout << (rebalance ? "开启重平衡" : "关闭重平衡") << "  第二阶段命中率: " << std::fixed << std::setprecision(2)
+              << 100.0 * hits / (hits + misses) << "%" << std::endl;
+
+    if (rebalance)
+    {
+      // 删掉三分之一的大对象，留下稀疏页，再逐步整理
+      for (int key = KEYS; key < 2 * KEYS; key += 3)
+      {
+        slab.remove("key:" + std::to_string(key));
       }
-      else if (op < PHASE_LENGTH * 4)
-      { // 阶段4: 局部性随机 - 优化局部性区域大小
-        // 产生5个局部区域，每个区域大小为15个键，与缓存大小20接近但略小
-        int locality = (op / 800) % 5;      // 调整为5个局部区域
-        key = locality * 15 + (gen() % 15); // 每区域15个键
+      size_t freeBefore = slab.memoryStats().freePageBytes;
+      for (int i = 0; i < 1000; ++i)
+      {
+        slab.maintain();
       }
+      size_t freeAfter = slab.memoryStats().freePageBytes;
+      std::cout << "删除后碎片整理腾出页: " << ((freeAfter - freeBefore) >> 20) << " MB" << std::endl;
+    }
+  }
+}
+
+// 回放同一个负载，打印命中率、每条目堆占用与耗时
+template <typename Cache>
+void runFlatLru(const std::string &name, int capacity, const std::vector<RainCache::WorkloadOp> &ops)
+{
+  size_t heapBefore = mallinfo2().uordblks;
+  Timer timer;
+  Cache cache(capacity);
+  int value = 0;
+  for (const RainCache::WorkloadOp &op : ops)
+  {
+    int key = static_cast<int>(op.key);
+    if (!cache.get(key, value))
+      cache.put(key, key);
+  }
+  double ms = timer.elapsed();
+  size_t heapBytes = mallinfo2().uordblks - heapBefore;
+  std::cout << std::left << std::setw(20) << name << std::right
+            << "  命中率: " << std::fixed << std::setprecision(2) << 100.0 * cache.stats().hitRate() << "%"
+            << "  每条目: " << static_cast<double>(heapBytes) / capacity << " B"
+            << "  (数据 " << sizeof(int) * 2 << " B)"
+            << "  耗时: " << ms << " ms" << std::endl;
+}
+
+// 小 key/value 内联在索引槽中的扁平 LRU 与基于节点的 RainLru 对比
+void testFlatLru()
+{
+  std::cout << "\n=== 测试场景11：小对象扁平 LRU ===" << std::endl;
+
+  const int CAPACITY = 200000;   // 缓存容量
+  const int KEYS = 1000000;      // key 范围
+  const int OPERATIONS = 3000000; // 总操作次数
+
+  RainCache::Workload workload;
+  workload.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
+
+  runFlatLru<RainCache::RainLru<int, int>>("RainLru<int,int>", CAPACITY, ops);
+  runFlatLru<RainCache::RainLruFor<int, int>>("RainFlatLru<int,int>", CAPACITY, ops);
+
+  // 容量为 0 时与 RainLru(0) 一样什么都不缓存，而不是越界访问
+  RainCache::RainFlatLru<int, int> empty(0);
+  int value = 0;
+  empty.put(1, 1);
+  empty.remove(1);
+  bool anyHit = empty.get(1, value) || empty.contains(1);
+  std::cout << "RainFlatLru<int,int>(0)  put/get/contains/remove: " << (anyHit ? "意外命中" : "全部未命中") << std::endl;
+}
+
+// 组相联缓存与全局链表 LRU 的命中率与单线程吞吐对比
+void testSetAssoc()
+{
+  std::cout << "\n=== 测试场景12：组相联缓存 ===" << std::endl;
+
+  const int CAPACITY = 65536;     // 缓存容量，取 2 的幂使组相联缓存的实际容量与之相同
+  const int KEYS = 1000000;       // key 范围
+  const int OPERATIONS = 2000000; // 总操作次数
+
+  RainCache::Workload workload;
+  workload.addPhase(OPERATIONS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(OPERATIONS);
+
+  auto run = [&](const std::string &name, RainCache::RainCache<int, int> &cache)
+  {
+    int hits = 0;
+    int value = 0;
+    Timer timer;
+    for (const RainCache::WorkloadOp &op : ops)
+    {
+      int key = static_cast<int>(op.key);
+      if (cache.get(key, value))
+        ++hits;
       else
-      { // 阶段5: 混合访问 - 增加热点访问比例
-        int r = gen() % 100;
-        if (r < 40)
-        {                  // 40%概率访问热点（从30%增加）
-          key = gen() % 5; // 5个热点键
-        }
-        else if (r < 70)
-        {                         // 30%概率访问中等范围
-          key = 5 + (gen() % 45); // 缩小中等范围为50个键
-        }
+        cache.put(key, key);
+    }
+    double ms = std::max(timer.elapsed(), 1.0);
+    std::cout << std::left << std::setw(20) << name << std::right
+              << "  命中率: " << std::fixed << std::setprecision(2) << 100.0 * hits / OPERATIONS << "%"
+              << "  吞吐: " << OPERATIONS / ms / 1000.0 << " Mops/s" << std::endl;
+  };
+
+  RainCache::RainLru<int, int> lru(CAPACITY);
+  RainCache::RainSetAssoc<int, int, 8> setAssoc8(CAPACITY);
+  RainCache::RainSetAssoc<int, int, 16> setAssoc16(CAPACITY);
+  run("RainLru", lru);
+  run("RainSetAssoc<8>", setAssoc8);
+  run("RainSetAssoc<16>", setAssoc16);
+}
+
+// 每个请求新建一个小缓存做记忆化：对比 RainLru 与定长 RainFixedLru 的构造 + 查询开销
+void testFixedLru()
+{
+  std::cout << "\n=== 测试场景13：请求级定长 LRU ===" << std::endl;
+
+  const int CAPACITY = 16;        // 每个请求的缓存容量
+  const int REQUESTS = 50000;     // 请求数
+  const int LOOKUPS = 64;         // 每个请求内的查询次数
+  const int KEYS = 64;            // 每个请求内的 key 范围
+
+  RainCache::Workload workload;
+  workload.addPhase(REQUESTS * LOOKUPS, 0, std::make_unique<RainCache::ZipfKeys>(KEYS, 0.9));
+  const std::vector<RainCache::WorkloadOp> ops = workload.generate(REQUESTS * LOOKUPS);
+
+  auto run = [&](const std::string &name, auto makeCache)
+  {
+    long long hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int request = 0; request < REQUESTS; ++request)
+    {
+      auto cache = makeCache();
+      int value = 0;
+      for (int i = 0; i < LOOKUPS; ++i)
+      {
+        int key = static_cast<int>(ops[request * LOOKUPS + i].key);
+        if (cache->get(key, value))
+          ++hits;
         else
-        {                           // 30%概率访问大范围（从40%减少）
-          key = 50 + (gen() % 350); // 大范围也相应缩小
-        }
+          cache->put(key, key);
       }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(28) << name << std::right
+              << "  命中率: " << std::fixed << std::setprecision(2) << 100.0 * hits / (REQUESTS * LOOKUPS) << "%"
+              << "  每个请求: " << ns / REQUESTS << " ns" << std::endl;
+  };
+
+  run("RainLru<int,int>(16)", [&]()
+      { return std::make_unique<RainCache::RainLru<int, int>>(CAPACITY); });
+  // 定长缓存放在栈上，用 optional 统一成指针式访问
+  run("RainFixedLru<int,int,16>", [&]()
+      { return std::optional<RainCache::RainFixedLru<int, int, CAPACITY>>(std::in_place); });
+}
 
-      if (isPut)
+// 每个线程回放自己的操作序列（get 未命中时回填），返回总吞吐（Mops/s）
+template <typename Cache>
+double runThreadOps(Cache &cache, const std::vector<std::vector<RainCache::WorkloadOp>> &ops)
+{
+  std::vector<std::thread> threads;
+  size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &threadOps : ops)
+  {
+    total += threadOps.size();
+    threads.emplace_back([&cache, &threadOps]()
+                         {
+      int value = 0;
+      for (const RainCache::WorkloadOp &op : threadOps)
       {
-        // 执行写操作
-        std::string value = "value" + std::to_string(key) + "_p" + std::to_string(phase);
-        caches[i]->put(key, value);
-      }
-      else
+        int key = static_cast<int>(op.key);
+        if (op.isPut || !cache.get(key, value))
+          cache.put(key, key);
+      } });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  double ms = std::max(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(), 1e-3);
+  return total / ms / 1000.0;
+}
+
+// 每个线程一份 Zipf 操作序列
+std::vector<std::vector<RainCache::WorkloadOp>> makeThreadOps(int threadNum, int opsPerThread, int keys, double theta, int putPercent)
+{
+  std::vector<std::vector<RainCache::WorkloadOp>> ops;
+  for (int t = 0; t < threadNum; ++t)
+  {
+    RainCache::Workload workload(RainCache::kDefaultWorkloadSeed + t);
+    workload.addPhase(opsPerThread, putPercent, std::make_unique<RainCache::ZipfKeys>(keys, theta));
+    ops.push_back(workload.generate(opsPerThread));
+  }
+  return ops;
+}
+
+// 读多写少的倾斜负载下，RainLruHash 开启与关闭每线程近端缓存的吞吐对比
+void testNearCache()
+{
+  std::cout << "\n=== 测试场景14：线程局部近端缓存 ===" << std::endl;
+
+  const int CAPACITY = 16384;          // 缓存总容量
+  const int SLICE_NUM = 16;            // 分片数量
+  const int KEYS = 100000;             // key 范围
+  const int OPS_PER_THREAD = 200000;   // 每个线程的操作次数
+  const int PUT_PERCENT = 1;           // 写比例
+
+  for (int threadNum : {1, 4, 16})
+  {
+    const auto ops = makeThreadOps(threadNum, OPS_PER_THREAD, KEYS, 0.99, PUT_PERCENT);
+
+    for (bool near : {false, true})
+    {
+      RainCache::RainLruHash<int, int> cache(CAPACITY, SLICE_NUM);
+      if (near)
+        cache.enableNearCache(512);
+
+      double mops = runThreadOps(cache, ops);
+
+      uint64_t nearHits = near ? cache.nearCacheHits() : 0;
+      RainCache::CacheStatsSnapshot stats = cache.stats();
+      uint64_t gets = stats.hits + stats.misses + nearHits;
+      std::cout << "线程数: " << std::setw(2) << threadNum << (near ? "  开启近端缓存" : "  关闭近端缓存")
+                << "  吞吐: " << std::fixed << std::setprecision(2) << mops << " Mops/s"
+                << "  命中率: " << 100.0 * (stats.hits + nearHits) / gets << "%"
+                << "  近端命中占比: " << 100.0 * nearHits / gets << "%" << std::endl;
+    }
+  }
+}
+
+// 极度倾斜的负载把最热的 key 都压到少数分片上，对比开启热点检测与按核复制前后的吞吐，并打印检测到的热点
+void testHotReplication()
+{
+  std::cout << "\n=== 测试场景15：热点检测与按核复制 ===" << std::endl;
+
+  const int CAPACITY = 16384;        // 缓存总容量
+  const int SLICE_NUM = 16;          // 分片数量
+  const int KEYS = 100000;           // key 范围
+  const int THREADS = 16;            // 线程数
+  const int OPS_PER_THREAD = 100000; // 每个线程的操作次数
+
+  const auto ops = makeThreadOps(THREADS, OPS_PER_THREAD, KEYS, 1.2, 1);
+  for (bool replicate : {false, true})
+  {
+    RainCache::RainLruHash<int, int> cache(CAPACITY, SLICE_NUM);
+    if (replicate)
+      cache.enableHotReplication(64, 0.01);
+    double mops = runThreadOps(cache, ops);
+
+    uint64_t replicaHits = replicate ? cache.hotReplicaHits() : 0;
+    RainCache::CacheStatsSnapshot stats = cache.stats();
+    uint64_t gets = stats.hits + stats.misses + replicaHits;
+    std::cout << (replicate ? "开启复制" : "关闭复制") << "  吞吐: " << std::fixed << std::setprecision(2) << mops << " Mops/s"
+              << "  命中率: " << 100.0 * (stats.hits + replicaHits) / gets << "%"
+              << "  副本命中占比: " << 100.0 * replicaHits / gets << "%" << std::endl;
+
+    if (replicate)
+    {
+      std::vector<RainCache::HeavyHitter<int>> hot = cache.hotKeys();
+      std::cout << "采样热点 (key/分片/估计次数):";
+      for (size_t i = 0; i < std::min<size_t>(hot.size(), 5); ++i)
       {
-        // 执行读操作并记录命中情况
-        std::string result;
-        get_operations[i]++;
-        if (caches[i]->get(key, result))
-        {
-          hits[i]++;
-        }
+        std::cout << "  " << hot[i].key << "/" << std::hash<int>{}(hot[i].key) % SLICE_NUM << "/" << hot[i].count;
       }
+      std::cout << std::endl;
+    }
+  }
+}
+
+// 限制 LRU 提升频率：对比不限制、按位置窗口、按时间间隔三种方式的命中率、吞吐与跳过的链表移动
+void testPromotionThrottle()
+{
+  std::cout << "\n=== 测试场景16：LRU 提升频率限制 ===" << std::endl;
+
+  const int CAPACITY = 16384;        // 缓存容量
+  const int KEYS = 100000;           // key 范围
+  const int THREADS = 4;             // 线程数
+  const int OPS_PER_THREAD = 500000; // 每个线程的操作次数
+
+  const auto ops = makeThreadOps(THREADS, OPS_PER_THREAD, KEYS, 0.99, 5);
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    RainCache::RainLru<int, int> lru(CAPACITY);
+    std::string name = "不限制";
+    if (mode == 1)
+    {
+      lru.setPromotionWindow(0.25);
+      name = "最新 25% 内不提升";
     }
+    else if (mode == 2)
+    {
+      lru.setPromotionInterval(std::chrono::milliseconds(10));
+      name = "10ms 内不重复提升";
+    }
+    double mops = runThreadOps(lru, ops);
+    RainCache::CacheStatsSnapshot stats = lru.stats();
+    std::cout << name << "  吞吐: " << std::fixed << std::setprecision(2) << mops << " Mops/s"
+              << "  命中率: " << 100.0 * stats.hitRate() << "%"
+              << "  跳过的提升: " << 100.0 * lru.skippedPromotions() / std::max<uint64_t>(stats.hits, 1) << "%" << std::endl;
   }
+}
 
-  printResults("工作负载剧烈变化测试", CAPACITY, get_operations, hits);
+// ARC 一侧容量被幽灵命中调到 0 后，晋升与写入不应丢失数据
+void testArcZeroCapacity()
+{
+  std::cout << "\n=== 测试场景17：ARC 单侧容量为 0 ===" << std::endl;
+
+  std::string value;
+
+  // 两次 LRU 幽灵命中把 LFU 部分容量调到 0，再命中一个达到晋升门槛的 key
+  RainCache::RainArc<int, std::string> lfuDrained(2, 2);
+  for (int key = 1; key <= 4; ++key)
+  {
+    lfuDrained.put(key, "v" + std::to_string(key));
+  }
+  lfuDrained.get(1, value);
+  lfuDrained.get(2, value);
+  lfuDrained.put(5, "v5");
+  bool promoted = lfuDrained.get(5, value);
+  bool kept = lfuDrained.get(5, value) && value == "v5";
+  std::cout << "LFU 容量为 0 时晋升: 首次命中 " << (promoted ? "是" : "否")
+            << "  晋升后仍可读取 " << (kept ? "是" : "否") << std::endl;
+
+  // 一次 LFU 幽灵命中把 LRU 部分容量调到 0，再写入一个新 key
+  RainCache::RainArc<int, std::string> lruDrained(1, 2);
+  lruDrained.put(1, "v1");
+  lruDrained.get(1, value);
+  lruDrained.put(2, "v2");
+  lruDrained.get(2, value);
+  lruDrained.get(1, value);
+  lruDrained.put(3, "v3");
+  bool stored = lruDrained.get(3, value) && value == "v3";
+  std::cout << "LRU 容量为 0 时写入: 写入后可读取 " << (stored ? "是" : "否") << std::endl;
+}
+
+// 大快照加载到容量更小的缓存：按加载方自身的容量截断，加载过程不触发淘汰回调
+void testSnapshotShrink()
+{
+  std::cout << "\n=== 测试场景18：快照加载到更小的缓存 ===" << std::endl;
+
+  const int LARGE = 1000; // 保存方容量与条目数
+  const int SMALL = 10;   // 加载方容量
+  const std::string path = "raincache_shrink_test.snap";
+
+  RainCache::RainArc<int, int> large(LARGE);
+  int value = 0;
+  for (int key = 0; key < LARGE; ++key)
+  {
+    large.put(key, key);
+    if (key % 2 == 0)
+      large.get(key, value);
+  }
+  large.saveSnapshot(path);
+
+  RainCache::RainArc<int, int> small(SMALL);
+  int evicted = 0;
+  small.setEvictionCallback([&evicted](const int &, const int &)
+                            { ++evicted; });
+  bool loaded = small.loadSnapshot(path);
+  size_t loadedSize = small.size();
+  int loadEvictions = evicted;
+  for (int key = LARGE; key < 2 * LARGE; ++key)
+  {
+    small.put(key, key);
+  }
+  std::remove(path.c_str());
+  std::cout << "ARC(" << LARGE << ") -> ARC(" << SMALL << ")  加载: " << (loaded ? "成功" : "失败")
+            << "  加载后驻留: " << loadedSize << "  加载时淘汰回调: " << loadEvictions
+            << "  再写入 " << LARGE << " 个 key 后驻留: " << small.size()
+            << " (上限 " << 2 * SMALL << ")" << std::endl;
+
+  RainCache::RainLru<int, int> largeLru(LARGE);
+  for (int key = 0; key < LARGE; ++key)
+  {
+    largeLru.put(key, key);
+  }
+  largeLru.saveSnapshot(path);
+
+  RainCache::RainLru<int, int> smallLru(SMALL);
+  evicted = 0;
+  smallLru.setEvictionCallback([&evicted](const int &, const int &)
+                               { ++evicted; });
+  loaded = smallLru.loadSnapshot(path);
+  std::remove(path.c_str());
+  // 保留的应是最近写入的 SMALL 个 key
+  int kept = 0;
+  for (int key = LARGE - SMALL; key < LARGE; ++key)
+  {
+    kept += smallLru.contains(key);
+  }
+  std::cout << "LRU(" << LARGE << ") -> LRU(" << SMALL << ")  加载: " << (loaded ? "成功" : "失败")
+            << "  保留最近的 key: " << kept << "/" << SMALL << "  加载时淘汰回调: " << evicted
+            << "  统计中的淘汰: " << smallLru.stats().evictions << std::endl;
+
+  // CAR / ARC-Adaptive：读入时就按容量截断，加载不计入淘汰统计
+  auto shrinkClock = [&](const std::string &name, auto &largeCache, auto &smallCache)
+  {
+    for (int key = 0; key < LARGE; ++key)
+    {
+      largeCache.put(key, key);
+      if (key % 2 == 0)
+        largeCache.get(key, value);
+    }
+    largeCache.saveSnapshot(path);
+    bool ok = smallCache.loadSnapshot(path);
+    std::remove(path.c_str());
+    uint64_t loadEvictions = smallCache.stats().evictions;
+    int resident = 0;
+    for (int key = 0; key < LARGE; ++key)
+    {
+      resident += smallCache.get(key, value);
+    }
+    std::cout << name << "(" << LARGE << ") -> " << name << "(" << SMALL << ")  加载: " << (ok ? "成功" : "失败")
+              << "  加载后驻留: " << resident << " (上限 " << SMALL << ")  统计中的淘汰: " << loadEvictions << std::endl;
+  };
+  RainCache::RainCar<int, int> largeCar(LARGE), smallCar(SMALL);
+  shrinkClock("CAR", largeCar, smallCar);
+  RainCache::RainArcAdaptive<int, int> largeAdaptive(LARGE), smallAdaptive(SMALL);
+  shrinkClock("ARC-Adaptive", largeAdaptive, smallAdaptive);
+
+  // 文件头中的容量与条目数被篡改成极大值、后面没有条目：应返回 false，不按条目数分配内存，原有内容保留
+  const uint64_t HUGE_COUNT = ~0ULL >> 4;
+  {
+    RainCache::SnapshotWriter out;
+    out.open(path);
+    out.writeHeader(RainCache::SnapshotPolicy::Arc);
+    out.writePod<uint64_t>(HUGE_COUNT); // LRU 部分容量
+    out.writePod<uint64_t>(HUGE_COUNT); // LRU 部分条目数
+    out.close();
+  }
+  RainCache::RainArc<int, int> corrupted(SMALL);
+  corrupted.put(1, 1);
+  bool threw = false;
+  try
+  {
+    loaded = corrupted.loadSnapshot(path);
+  }
+  catch (const std::exception &)
+  {
+    threw = true;
+  }
+  std::remove(path.c_str());
+  std::cout << "ARC 损坏的文件头  加载: " << (threw ? "抛出异常" : loaded ? "成功" : "失败")
+            << "  原有内容保留: " << (corrupted.get(1, value) && value == 1 ? "是" : "否") << std::endl;
+
+  // 文件声明 5 条、只写了 2 条就截断：LRU / LFU 应返回 false，原有内容保留
+  auto writeTruncated = [&](RainCache::SnapshotPolicy policy, bool withFreq)
+  {
+    RainCache::SnapshotWriter out;
+    out.open(path);
+    out.writeHeader(policy);
+    out.writePod<uint64_t>(5);
+    for (int key = 100; key < 102; ++key)
+    {
+      if (withFreq)
+        out.writePod<int32_t>(1);
+      out.writePod<int>(key);
+      out.writePod<int>(key);
+    }
+    out.close();
+  };
+  RainCache::RainLru<int, int> liveLru(SMALL);
+  liveLru.put(1, 1);
+  writeTruncated(RainCache::SnapshotPolicy::Lru, false);
+  bool lruLoaded = liveLru.loadSnapshot(path);
+  bool lruKept = liveLru.get(1, value) && value == 1 && !liveLru.get(100, value);
+  RainCache::RainLfu<int, int> liveLfu(SMALL);
+  liveLfu.put(1, 1);
+  writeTruncated(RainCache::SnapshotPolicy::Lfu, true);
+  bool lfuLoaded = liveLfu.loadSnapshot(path);
+  bool lfuKept = liveLfu.get(1, value) && value == 1 && !liveLfu.get(100, value);
+  std::remove(path.c_str());
+  std::cout << "LRU 截断的文件  加载: " << (lruLoaded ? "成功" : "失败") << "  原有内容保留: " << (lruKept ? "是" : "否") << std::endl;
+  std::cout << "LFU 截断的文件  加载: " << (lfuLoaded ? "成功" : "失败") << "  原有内容保留: " << (lfuKept ? "是" : "否") << std::endl;
 }
 
 int main()
@@ -357,5 +1301,20 @@ int main()
   testHotDataAccess();
   testLoopPattern();
   testWorkloadShift();
+  testShardScaling();
+  testStaticComposition();
+  testShardLatency();
+  testSnapshotRestart();
+  testTieredCache();
+  testSlabMemory();
+  testSlabRebalance();
+  testFlatLru();
+  testSetAssoc();
+  testFixedLru();
+  testNearCache();
+  testHotReplication();
+  testPromotionThrottle();
+  testArcZeroCapacity();
+  testSnapshotShrink();
   return 0;
 }
\ No newline at end of file